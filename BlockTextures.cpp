@@ -0,0 +1,44 @@
+#include "BlockTextures.h"
+
+const std::vector<std::pair<std::string, int>> textureWeights = {
+    {"assets/cobbled_deepslate.png", 200},
+    {"assets/deepslate.png", 400},
+    {"assets/deepslate_coal_ore.png", 60},
+    {"assets/deepslate_copper_ore.png", 40},
+    {"assets/deepslate_iron_ore.png", 30},
+    {"assets/deepslate_gold_ore.png", 20},
+    {"assets/deepslate_lapis_ore.png", 15},
+    {"assets/deepslate_redstone_ore.png", 10},
+    {"assets/deepslate_emerald_ore.png", 7},
+};
+
+namespace {
+
+std::vector<int> getWeights(const std::vector<std::pair<std::string, int>>& textureWeights) {
+    std::vector<int> weights;
+    for (const auto& tex : textureWeights) {
+        weights.push_back(tex.second);
+    }
+    return weights;
+}
+
+}
+
+const AliasTable textureTable(getWeights(textureWeights));
+
+std::string getRandomTexture(Random& rng) {
+    return textureWeights[getRandomTextureIndex(rng)].first;
+}
+
+int getRandomTextureIndex(Random& rng) {
+    return textureTable.sample(rng);
+}
+
+std::vector<std::string> getBlockTexturePaths() {
+    std::vector<std::string> paths;
+    for (const auto& tex : textureWeights) {
+        paths.push_back(tex.first);
+    }
+    paths.push_back(MAZE_END_TEXTURE);
+    return paths;
+}
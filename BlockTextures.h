@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Random.h"
+
+#define MAZE_END_TEXTURE "assets/deepslate_diamond_ore.png"
+
+// Texture weights for random texture selection
+extern const std::vector<std::pair<std::string, int>> textureWeights;
+
+// Alias table over textureWeights, built once at startup
+extern const AliasTable textureTable;
+
+/**
+ * @brief Function to get a random texture based on weights.
+ *
+ * @param rng The generator to draw from.
+ * @return std::string - Randomly selected texture path.
+ */
+std::string getRandomTexture(Random& rng);
+
+/**
+ * @brief Function to get the index of a random texture based on weights, in constant time.
+ *
+ * @param rng The generator to draw from.
+ * @return int - Index of the selected texture in textureWeights, which is also its texture array layer.
+ */
+int getRandomTextureIndex(Random& rng);
+
+/**
+ * @brief Lists the layers of the block texture array.
+ *
+ * The weighted textures come first in their textureWeights order, MAZE_END_TEXTURE is the last layer.
+ *
+ * @return std::vector<std::string> - Texture paths by layer.
+ */
+std::vector<std::string> getBlockTexturePaths();
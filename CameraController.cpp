@@ -1,100 +1,152 @@
 #include "CameraController.h"
-
-CameraController::CameraController(osgViewer::Viewer *inputViewer, std::vector<std::vector<CellType>> inputMazeVec) : 
-    viewer(inputViewer), 
-    movement(osg::Vec3d()), 
-    mazeVec(inputMazeVec),
-    foundExitFlag(false)
+#include "InputRecording.h"
+
+CameraController::CameraController(osgViewer::View *inputView, std::shared_ptr<const MazeGrid> inputMaze,
+                                   const KeyBindings& inputKeys) :
+    viewer(inputView),
+    keys(inputKeys),
+    heldKeys(0),
+    lastFrameTime(-1.0),
+    timeAccumulator(0.0),
+    maze(inputMaze),
+    collision(inputMaze, distanceFromWall),
+    foundExitFlag(false),
+    handleTime(0.0),
+    handledEvents(0),
+    recorder(nullptr)
 { }
 
 bool leftMouseButtonPressed = false;
 
 bool CameraController::handle(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &aa) {
+    osg::Timer_t startTick = osg::Timer::instance()->tick();
+    if (recorder) {
+        recorder->recordEvent(ea);
+    }
+    bool handled = handleEvent(ea, aa);
+    if (recorder && ea.getEventType() == osgGA::GUIEventAdapter::FRAME) {
+        recorder->recordPose(getMatrix());
+    }
+    handleTime += osg::Timer::instance()->delta_m(startTick, osg::Timer::instance()->tick());
+    handledEvents++;
+    return handled;
+}
+
+bool CameraController::replayEvent(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &aa) {
+    return handle(ea, aa);
+}
+
+void CameraController::setRecorder(InputRecorder* inputRecorder) {
+    recorder = inputRecorder;
+}
+
+void CameraController::resetHandleStats() {
+    handleTime = 0.0;
+    handledEvents = 0;
+}
+
+bool CameraController::handleEvent(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &aa) {
     FirstPersonManipulator::handle(ea, aa);
     if (!viewer) {
         return false;
     }
 
-    // Skip movement calculation when mouse moves or drags to avoid speeding up effect
-    if (ea.getEventType() == osgGA::GUIEventAdapter::MOVE || ea.getEventType() == osgGA::GUIEventAdapter::DRAG) {
+    switch(ea.getEventType()) {
+        case(osgGA::GUIEventAdapter::KEYDOWN):
+        case(osgGA::GUIEventAdapter::KEYUP): {
+            handleKey(ea);
+            break;
+        }
+        case(osgGA::GUIEventAdapter::FRAME): {
+            integrateMovement(ea.getTime());
+            break;
+        }
+        default:
+            break;
+    }
+
+    return true;
+}
+
+bool CameraController::handleKey(const osgGA::GUIEventAdapter &ea) {
+    unsigned heldKey = getHeldKey(ea.getKey());
+    if (ea.getEventType() == osgGA::GUIEventAdapter::KEYUP) {
+        heldKeys &= ~heldKey;
+        return heldKey != 0;
+    }
+
+    heldKeys |= heldKey;
+    if (ea.getKey() == keys.hint) { // Show the way to the exit
+        osg::Matrix matrix = getMatrix();
+        printHint(matrix.getTrans(), matrix.getRotate());
         return true;
     }
+    return heldKey != 0;
+}
+
+unsigned CameraController::getHeldKey(int key) const {
+    if (key == keys.forward) return KEY_FORWARD;
+    if (key == keys.back) return KEY_BACK;
+    if (key == keys.left) return KEY_LEFT;
+    if (key == keys.right) return KEY_RIGHT;
+    if (key == keys.rotateLeft) return KEY_ROTATE_LEFT;
+    if (key == keys.rotateRight) return KEY_ROTATE_RIGHT;
+    return 0;
+}
+
+void CameraController::integrateMovement(double time) {
+    double frameTime = lastFrameTime < 0.0 ? 0.0 : std::min(time - lastFrameTime, maxFrameTime);
+    lastFrameTime = time;
+    timeAccumulator += std::max(frameTime, 0.0);
 
-    osg::Matrix matrix = viewer->getCameraManipulator()->getMatrix();
+    osg::Matrix matrix = getMatrix();
     osg::Vec3d camPos = matrix.getTrans();
 
     if (checkIfFinsihed(camPos)) {
-        // viewer->setDone(true);
-        return true;
+        return;
     }
 
-    osg::Quat camRotation = matrix.getRotate();
-    bool isMoved = true;
+    // Nothing to integrate, drop the time so a later key press does not jump
+    if (!heldKeys) {
+        timeAccumulator = 0.0;
+        return;
+    }
 
-    switch(ea.getEventType()) {
-        case(osgGA::GUIEventAdapter::KEYDOWN): {
-            switch(ea.getKey()) {
-                case 'w': // Move foreward
-                    movement.z() = -moveStep;
-                    isMoved = true;
-                    break;
-                case 's': // Move to the back
-                    movement.z() = moveStep;
-                    isMoved = true;
-                    break;
-                case 'a': // Move to the left
-                    movement.x() = -moveStep;
-                    isMoved = true;
-                    break;
-                case 'd': // Move to the right
-                    movement.x() = moveStep;
-                    isMoved = true;
-                    break;
-                case 'e': // Rotate camera to the right
-                    camRotation *= osg::Quat(osg::DegreesToRadians(-rotateAngle), osg::Z_AXIS);
-                    matrix.setRotate(camRotation);
-                    break;
-                case 'q': // Rotate camera to the left
-                    camRotation *= osg::Quat(osg::DegreesToRadians(rotateAngle), osg::Z_AXIS);
-                    matrix.setRotate(camRotation);
-                    break;
-                default:
-                    break;
-            }
-            break;
-        }
-        case(osgGA::GUIEventAdapter::KEYUP): {
-            switch(ea.getKey()) {
-                case 'w':
-                    movement.z() = 0.0;
-                    break;
-                case 's':
-                    movement.z() = 0.0;
-                    break;
-                case 'a':
-                    movement.x() = 0.0;
-                    break;
-                case 'd':
-                    movement.x() = 0.0;
-                    break;
-                default:
-                    break;
-            }
-        }
+    osg::Quat camRotation = matrix.getRotate();
+    for (; timeAccumulator >= fixedTimeStep; timeAccumulator -= fixedTimeStep) {
+        stepMovement(camPos, camRotation);
     }
 
-    camPos += camRotation * movement;
-    camPos.z() = zPos;
+    // Apply the modified matrix once per frame, also when a replay drives the controller without the view
+    matrix.setRotate(camRotation);
+    matrix.setTrans(camPos);
+    setByMatrix(matrix);
+}
 
-    // Check if move is valid and adjust camera position accordingly
-    if (checkMove(camPos) && isMoved) {
-        matrix.setTrans(correctDistanceFromWalls(camPos));
+void CameraController::stepMovement(osg::Vec3d& pos, osg::Quat& rotation) {
+    double angle = 0.0;
+    if (heldKeys & KEY_ROTATE_LEFT) angle += rotateSpeed;
+    if (heldKeys & KEY_ROTATE_RIGHT) angle -= rotateSpeed;
+    if (angle != 0.0) {
+        rotation *= osg::Quat(osg::DegreesToRadians(angle * fixedTimeStep), osg::Z_AXIS);
     }
 
-    // Apply the modified matrix to the viewer's camera manipulator
-    viewer->getCameraManipulator()->setByMatrix(matrix);
+    // The camera looks along its negative z-axis, x points to its right
+    osg::Vec3d movement;
+    if (heldKeys & KEY_FORWARD) movement.z() -= 1.0;
+    if (heldKeys & KEY_BACK) movement.z() += 1.0;
+    if (heldKeys & KEY_LEFT) movement.x() -= 1.0;
+    if (heldKeys & KEY_RIGHT) movement.x() += 1.0;
+    if (movement.length2() == 0.0) {
+        return;
+    }
+    movement.normalize();
 
-    return true;
+    osg::Vec3d camPos = pos + rotation * (movement * (moveSpeed * fixedTimeStep));
+    camPos.z() = zPos;
+
+    // Stop at the walls and slide along them
+    pos = collision.move(pos, camPos);
 }
 
 void CameraController::setInitCamPos(int x, int y) {
@@ -112,13 +164,13 @@ std::pair<int, int> CameraController::getValidInitCenterPos(int x, int y) {
     std::pair<int, int> validIndices(x, y);
 
     // Get valid center position to avoid looking at the wall
-    if (x-1 >= 0 && mazeVec[x-1][y] != WALL) {
+    if (maze->contains(x-1, y) && maze->get(x-1, y) != WALL) {
         validIndices.first = x-1;
-    } else if (y-1 >= 0 && mazeVec[x][y-1] != WALL) {
+    } else if (maze->contains(x, y-1) && maze->get(x, y-1) != WALL) {
         validIndices.second = y-1;
-    } else if (x+1 < mazeVec.size() && mazeVec[x+1][y] != WALL) {
+    } else if (maze->contains(x+1, y) && maze->get(x+1, y) != WALL) {
         validIndices.first = x+1;
-    } else if (y+1 < mazeVec[0].size() && mazeVec[x][y+1] != WALL) {
+    } else if (maze->contains(x, y+1) && maze->get(x, y+1) != WALL) {
         validIndices.second = y+1;
     }
 
@@ -129,77 +181,63 @@ int CameraController::getMazeIndex(float val) {
     return static_cast<int>(std::round(val));
 }
 
-bool CameraController::checkMove(osg::Vec3d pos) {
+bool CameraController::checkIfFinsihed(osg::Vec3d pos) {
     int x = getMazeIndex(pos.x());
     int y = getMazeIndex(pos.y());
 
-    // Check if the move is within maze bounds and doesn't hit a wall
-    if (x >= 0 && x < mazeVec.size() && y >= 0 && y < mazeVec[0].size()) {
-        if (mazeVec[x][y] == WALL) {
-            return false; // Invalid move -> wall
-        } else {
-            return true; // Valid move -> no obstruction
-        }
+    if (maze->contains(x, y) && maze->get(x, y) == END) {
+        foundExitFlag = true;
+        return true;
     } else {
-        return false; // Invalid move -> outside maze bounds
+        return false;
     }
 }
 
-float CameraController::stepBackFromWall(float pos) {
-    float decimalPart = fmod(pos, 1.0);
-    float floorPos = floor(pos);
-
-    // Adjust position to step back from the wall based on the predefined distance
-    if (decimalPart >= 0.5 && decimalPart <= 0.5+distanceFromWall) {
-        pos = floorPos + 0.5 + distanceFromWall;
-    } else if (decimalPart >= 0.0 && decimalPart <= distanceFromWall) {
-        pos = floorPos + distanceFromWall;
-    } else if (decimalPart >= 1.0 - distanceFromWall) {
-        pos = ceil(pos) - distanceFromWall;
-    } else if (decimalPart <= 0.5 && decimalPart >= 0.5 - distanceFromWall) {
-        pos = floorPos + 0.5 - distanceFromWall;
-    }
-
-    return pos;
+bool CameraController::checkExit() {
+    return foundExitFlag;
 }
 
-osg::Vec3 CameraController::correctDistanceFromWalls(osg::Vec3 pos) {
-    osg::Vec3 camPosCopy(pos);
-    float checkDistance = distanceFromWall + 0.01;
-
-    // Lambda function to check and adjust the camera position along a coordinate axis
-    auto checkAndAdjust = [&](float& camPosCoord, float& camPosCopyCoord, const std::function<void(float&)>& adjustFunc) {
-        camPosCopyCoord += checkDistance;
-        if (!checkMove(camPosCopy)) {
-            adjustFunc(camPosCoord);
-        }
-
-        camPosCopyCoord -= 2 * checkDistance;
-        if (!checkMove(camPosCopy)) {
-            adjustFunc(camPosCoord);
-            camPosCopyCoord += checkDistance;
-        }
-    };
+void CameraController::setDistanceField(std::shared_ptr<const DistanceField> field) {
+    distanceField = field;
+}
 
-    // Check and adjust along the X-axis and Y-axis
-    checkAndAdjust(pos.x(), camPosCopy.x(), [&](float& pos) { pos = stepBackFromWall(pos); });
-    checkAndAdjust(pos.y(), camPosCopy.y(), [&](float& pos) { pos = stepBackFromWall(pos); });
+void CameraController::setMaze(std::shared_ptr<const MazeGrid> inputMaze, int x, int y) {
+    maze = inputMaze;
+    collision = MazeCollision(inputMaze, distanceFromWall);
+    distanceField.reset();
+    foundExitFlag = false;
+    timeAccumulator = 0.0;
 
-    return pos;
+    setInitCamPos(x, y);
+    home(0.0);
 }
 
-bool CameraController::checkIfFinsihed(osg::Vec3d pos) {
+void CameraController::printHint(osg::Vec3d pos, osg::Quat rotation) {
+    if (!distanceField) {
+        return;
+    }
+
     int x = getMazeIndex(pos.x());
     int y = getMazeIndex(pos.y());
-
-    if (mazeVec[x][y] == END) {
-        foundExitFlag = true;
-        return true;
-    } else {
-        return false;
+    uint32_t distance = distanceField->getDistance(x, y);
+    std::pair<int, int> step = distanceField->getHintStep(x, y);
+    if (distance == DistanceField::UNREACHABLE || (step.first == 0 && step.second == 0)) {
+        return;
     }
-}
 
-bool CameraController::checkExit() {
-    return foundExitFlag;
+    // Compare the step with where the camera looks, the camera looks along its negative z-axis
+    osg::Vec3d forward = rotation * osg::Vec3d(0.0, 0.0, -1.0);
+    osg::Vec3d right = rotation * osg::Vec3d(1.0, 0.0, 0.0);
+    double ahead = forward.x() * step.first + forward.y() * step.second;
+    double side = right.x() * step.first + right.y() * step.second;
+
+    const char* direction = "BEHIND YOU";
+    if (ahead >= std::fabs(side)) {
+        direction = "AHEAD";
+    } else if (side >= std::fabs(ahead)) {
+        direction = "TO THE RIGHT";
+    } else if (-side >= std::fabs(ahead)) {
+        direction = "TO THE LEFT";
+    }
+    std::cout << "--+> THE DIAMONDS ARE " << distance << " STEPS AWAY, GO " << direction << " <+--" << std::endl;
 }
\ No newline at end of file
@@ -4,10 +4,12 @@
 #define CAMERACONTROLLER_H
 
 #include "MazeGenerator.h"
+#include "MazeDistanceField.h"
+#include "MazeCollision.h"
 
 #include <osg/MatrixTransform>
 #include <osgGA/FirstPersonManipulator>
-#include <osgViewer/Viewer>
+#include <osgViewer/View>
 #include <osg/Timer>
 #include <osgText/Text>
 #include <iostream>
@@ -16,10 +18,50 @@
 #include <stdio.h>
 #include <unistd.h>
 
-const float moveStep = 0.02; // Step size for camera movement
-const float rotateAngle = 2.0; // Angle by which the camera rotates on rotate key press
+class InputRecorder;
+
+const float moveSpeed = 1.5; // Camera movement speed in units per second
+const float rotateSpeed = 90.0; // Camera rotation speed in degrees per second while a rotate key is held
+const double fixedTimeStep = 1.0 / 120.0; // Length of one movement integration step in seconds
+const double maxFrameTime = 0.25; // Longest frame that is integrated, the rest of a longer stall is dropped
+
+// Bits of CameraController::heldKeys
+enum HeldKey {
+    KEY_FORWARD = 1,
+    KEY_BACK = 2,
+    KEY_LEFT = 4,
+    KEY_RIGHT = 8,
+    KEY_ROTATE_LEFT = 16,
+    KEY_ROTATE_RIGHT = 32
+};
+
+/**
+ * @struct KeyBindings
+ * @brief Key codes moving one player, so several players can share a keyboard.
+ */
+struct KeyBindings {
+    int forward; // Move forward
+    int back; // Move back
+    int left; // Strafe left
+    int right; // Strafe right
+    int rotateLeft; // Rotate the camera to the left
+    int rotateRight; // Rotate the camera to the right
+    int hint; // Print the way to the exit
+};
+
+const int maxPlayers = 4; // Number of players with their own key bindings
+const KeyBindings playerKeys[maxPlayers] = {
+    {'w', 's', 'a', 'd', 'q', 'e', 'h'},
+    {osgGA::GUIEventAdapter::KEY_Up, osgGA::GUIEventAdapter::KEY_Down, osgGA::GUIEventAdapter::KEY_Left,
+     osgGA::GUIEventAdapter::KEY_Right, osgGA::GUIEventAdapter::KEY_Delete, osgGA::GUIEventAdapter::KEY_Page_Down,
+     osgGA::GUIEventAdapter::KEY_End},
+    {'p', ';', 'l', '\'', 'o', '[', '/'},
+    {osgGA::GUIEventAdapter::KEY_KP_8, osgGA::GUIEventAdapter::KEY_KP_5, osgGA::GUIEventAdapter::KEY_KP_4,
+     osgGA::GUIEventAdapter::KEY_KP_6, osgGA::GUIEventAdapter::KEY_KP_7, osgGA::GUIEventAdapter::KEY_KP_9,
+     osgGA::GUIEventAdapter::KEY_KP_0}
+};
 const float zPos = 0.25; // Z-coordinate for the camera position
-const float distanceFromWall = 0.15; // Minimum distance from walls
+const float distanceFromWall = 0.15; // Minimum distance from walls, the radius of the collision circle
 
 /**
  * @class CameraController
@@ -32,10 +74,12 @@ public:
     /**
      * @brief Constructor for CameraController.
      *
-     * @param inputViewer A pointer to the osgViewer::Viewer.
-     * @param inputMazeVec A 2D vector representing the maze.
+     * @param inputView A pointer to the view the controller moves, an osgViewer::Viewer or a view of a CompositeViewer.
+     * @param inputMaze The shared maze grid.
+     * @param inputKeys The keys moving this controller.
      */
-    CameraController(osgViewer::Viewer *inputViewer, std::vector<std::vector<CellType>> inputMazeVec);
+    CameraController(osgViewer::View *inputView, std::shared_ptr<const MazeGrid> inputMaze,
+                     const KeyBindings& inputKeys = playerKeys[0]);
 
     /**
      * @brief Sets the initial camera position in the maze.
@@ -54,16 +98,92 @@ public:
      */
     bool checkExit();
 
+    /**
+     * @brief Gets the time spent handling events since the last resetHandleStats() call.
+     *
+     * @return double - Time in milliseconds.
+     */
+    double getHandleTime() const { return handleTime; }
+
+    /**
+     * @brief Gets the number of events handled since the last resetHandleStats() call.
+     *
+     * @return int - Number of handled events.
+     */
+    int getHandledEvents() const { return handledEvents; }
+
+    /**
+     * @brief Resets the event handling counters, called once per frame.
+     */
+    void resetHandleStats();
+
+    /**
+     * @brief Sets the distance field used to answer hint requests.
+     *
+     * @param field The distance field of the maze, null disables hints.
+     */
+    void setDistanceField(std::shared_ptr<const DistanceField> field);
+
+    /**
+     * @brief Moves the camera into another maze, used to swap levels without recreating the controller.
+     *
+     * Clears the exit flag and the distance field and places the camera at the new starting point.
+     *
+     * @param inputMaze The shared grid of the new maze.
+     * @param x The x-coordinate of the starting point.
+     * @param y The y-coordinate of the starting point.
+     */
+    void setMaze(std::shared_ptr<const MazeGrid> inputMaze, int x, int y);
+
+    /**
+     * @brief Applies a key event to the held keys, also for keys pressed while another view has the focus.
+     *
+     * @param ea The GUIEventAdapter containing the KEYDOWN or KEYUP event.
+     * @return bool - True if the key belongs to this controller's bindings, false otherwise.
+     */
+    bool handleKey(const osgGA::GUIEventAdapter &ea);
+
+    /**
+     * @brief Gets the view moved by this controller.
+     *
+     * @return osgViewer::View* - The view.
+     */
+    osgViewer::View* getView() const { return viewer; }
+
+    /**
+     * @brief Sets the recorder receiving every handled key and FRAME event and the camera pose after each frame.
+     *
+     * @param inputRecorder The recorder, null stops recording.
+     */
+    void setRecorder(InputRecorder* inputRecorder);
+
+    /**
+     * @brief Passes a recorded event through handle(), used to drive a controller not attached to its view.
+     *
+     * @param ea The GUIEventAdapter containing the recorded event.
+     * @param aa The GUIActionAdapter containing action information.
+     * @return bool - True if the event is handled, false otherwise.
+     */
+    bool replayEvent(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &aa);
+
 protected:
-    osgViewer::Viewer *viewer; // Pointer to the osgViewer::Viewer
-    osg::Vec3d movement; // Vector representing camera movement
-    const std::vector<std::vector<CellType>> mazeVec; // 2D vector representing the maze
+    osgViewer::View *viewer; // Pointer to the view the controller moves
+    KeyBindings keys; // Keys moving this controller
+    unsigned heldKeys; // HeldKey bits of the movement keys currently pressed
+    double lastFrameTime; // Event time of the previous FRAME event in seconds, negative before the first one
+    double timeAccumulator; // Frame time not yet consumed by fixed integration steps
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+    MazeCollision collision; // Keeps the camera out of the walls
     bool foundExitFlag;
+    double handleTime; // Time spent in handle() since the last reset in milliseconds
+    int handledEvents; // Number of events passed to handle() since the last reset
+    std::shared_ptr<const DistanceField> distanceField; // Distance to the exit used for hints
+    InputRecorder* recorder; // Records the handled input, null while not recording
 
     /**
      * @brief Event handler for GUI events.
      *
-     * Handles keyboard events for camera movement and rotation.
+     * Times handleEvent() and counts the events for the frame statistics, and passes the events to the recorder.
      *
      * @param ea The GUIEventAdapter containing event information.
      * @param aa The GUIActionAdapter containing action information.
@@ -71,6 +191,43 @@ protected:
      */
     virtual bool handle(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &);
 
+    /**
+     * @brief Handles keyboard events for camera movement and rotation.
+     *
+     * Key events only update the held key state, the camera is moved once per FRAME event.
+     *
+     * @param ea The GUIEventAdapter containing event information.
+     * @param aa The GUIActionAdapter containing action information.
+     * @return bool - True if the event is handled, false otherwise.
+     */
+    bool handleEvent(const osgGA::GUIEventAdapter &ea, osgGA::GUIActionAdapter &aa);
+
+    /**
+     * @brief Gets the HeldKey bit of a movement key.
+     *
+     * @param key The key code.
+     * @return unsigned - The HeldKey bit, 0 if the key does not move the camera.
+     */
+    unsigned getHeldKey(int key) const;
+
+    /**
+     * @brief Advances the camera by the time elapsed since the previous frame in fixed steps.
+     *
+     * Speeds are given per second and every step has the same length, so the distance covered
+     * does not depend on the frame rate or on how many events the system delivers.
+     *
+     * @param time Event time of the current frame in seconds.
+     */
+    void integrateMovement(double time);
+
+    /**
+     * @brief Moves and rotates the camera by a single fixed time step.
+     *
+     * @param pos Camera position, updated in place.
+     * @param rotation Camera rotation, updated in place.
+     */
+    void stepMovement(osg::Vec3d& pos, osg::Quat& rotation);
+
     /**
      * @brief Gets valid initial center position based on specified coordinate. 
      *
@@ -94,44 +251,6 @@ protected:
      */
     int getMazeIndex(float val);
 
-    /**
-     * @brief Checks if specified position is valid within the ma.
-     *
-     * Checks if the rounded coordinates of the current camera position fall within 
-     * the maze bounds and if the corresponding maze cell is not a wall. 
-     * Returns true for a valid move, false otherwise.
-     * 
-     * @param pos The current camera position to be checked.
-     * @return bool - True if the move is valid, false otherwise.
-     */
-    bool checkMove(osg::Vec3d pos);
-
-    /**
-     * @brief Adjusts the given coordinate to step back from the wall.
-     *
-     * Takes a coordinate and adjusts it to step back from wall
-     * based on a predefined distance. Ensures that the adjusted position
-     * aligns with the wall grid to prevent the camera from being too close
-     * to walls.
-     * 
-     * @param pos The position to be adjusted.
-     * @return float - The adjusted position after stepping back from walls.
-     */
-    float stepBackFromWall(float pos);
-
-    /**
-     * @brief Adjusts the camera's distance from walls.
-     *
-     * Takes current camera position and adjusts it to ensure
-     * that it is at a safe distance from walls. It uses a step-back strategy
-     * to prevent the camera from peeking into the walls.
-     * 
-     * @param pos The current camera position.
-     * @return osg::Vec3 - The adjusted camera position.
-     */
-    osg::Vec3 correctDistanceFromWalls(osg::Vec3 pos);
-
-
     /**
      * @brief Checks if the given position corresponds to the finishing point in the maze.
      *
@@ -139,6 +258,14 @@ protected:
      * @return bool - true if the position corresponds to the finishing point, false otherwise.
      */
     bool checkIfFinsihed(osg::Vec3d pos);
+
+    /**
+     * @brief Prints how far the exit is and which way to turn to get closer.
+     *
+     * @param pos Current camera position.
+     * @param rotation Current camera rotation.
+     */
+    void printHint(osg::Vec3d pos, osg::Quat rotation);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "EllerGenerator.h"
+
+MazeFileSink::MazeFileSink(const std::string& path, const MazeFileInfo& info): path(path), info(info), written(false) { }
+
+void MazeFileSink::beginMaze(int size) {
+    info.size = size;
+    words.assign(MazeGrid::getRowWords(size), 0);
+
+    MazeFileHeader header;
+    fillMazeFileHeader(header, info);
+    file.open(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void MazeFileSink::writeRow(int /*x*/, const CellType* row) {
+    // Cells past the end of the row stay WALL, like the padding of a MazeGrid filled with WALL
+    uint64_t pattern = 0;
+    for (int i = 0; i < MazeGrid::CELLS_PER_WORD; i++) {
+        pattern |= uint64_t(WALL) << (2 * i);
+    }
+    std::fill(words.begin(), words.end(), pattern);
+    for (int j = 0; j < info.size; j++) {
+        uint64_t& word = words[j / MazeGrid::CELLS_PER_WORD];
+        int offset = (j % MazeGrid::CELLS_PER_WORD) * 2;
+        word = (word & ~(uint64_t(3) << offset)) | (uint64_t(row[j]) << offset);
+    }
+    file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+}
+
+void MazeFileSink::endMaze() {
+    file.close();
+    written = !file.fail();
+}
+
+bool MazeFileSink::isWritten() const {
+    return written;
+}
+
+size_t MazeFileSink::getMemoryUsage() const {
+    return words.capacity() * sizeof(uint64_t);
+}
+
+EllerGenerator::EllerGenerator(int size, uint64_t seed):
+    size(size),
+    cells((size - 1) / 2),
+    rng(seed),
+    sets(cells),
+    parent(2 * cells),
+    remaining(2 * cells),
+    hasDown(2 * cells),
+    down(cells),
+    row(size)
+{ }
+
+size_t EllerGenerator::getMemoryUsage() const {
+    return (sets.capacity() + parent.capacity() + remaining.capacity()) * sizeof(int)
+           + hasDown.capacity() + down.capacity() + row.capacity() * sizeof(CellType);
+}
+
+int EllerGenerator::find(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+void EllerGenerator::relabel() {
+    // Labels still in use by cells connected to the previous row
+    std::vector<unsigned char>& used = hasDown;
+    std::fill(used.begin(), used.end(), 0);
+    for (int c = 0; c < cells; c++) {
+        if (down[c]) {
+            used[sets[c]] = 1;
+        }
+    }
+
+    // At most cells labels are in use, so 2*cells labels always leave enough free ones
+    int freeLabel = 0;
+    for (int c = 0; c < cells; c++) {
+        if (!down[c]) {
+            while (used[freeLabel]) {
+                freeLabel++;
+            }
+            sets[c] = freeLabel++;
+        }
+    }
+}
+
+void EllerGenerator::generate(MazeRowSink& sink) {
+    sink.beginMaze(size);
+
+    // Top outer wall
+    std::fill(row.begin(), row.end(), WALL);
+    sink.writeRow(0, row.data());
+
+    for (int c = 0; c < cells; c++) {
+        sets[c] = c;
+    }
+
+    for (int r = 0; r < cells; r++) {
+        bool lastRow = r == cells - 1;
+        for (int label = 0; label < 2 * cells; label++) {
+            parent[label] = label;
+        }
+
+        // Cell row: randomly join neighbours from different sets, the last row joins them all
+        std::fill(row.begin(), row.end(), WALL);
+        for (int c = 0; c < cells; c++) {
+            row[2 * c + 1] = PATH;
+            if (c + 1 < cells) {
+                int a = find(sets[c]), b = find(sets[c + 1]);
+                if (a != b && (lastRow || rng.next() >> 63)) {
+                    parent[b] = a;
+                    row[2 * c + 2] = PATH;
+                }
+            }
+        }
+        for (int c = 0; c < cells; c++) {
+            sets[c] = find(sets[c]);
+        }
+        if (r == 0) {
+            row[1] = START;
+        }
+        sink.writeRow(2 * r + 1, row.data());
+
+        if (lastRow) {
+            break;
+        }
+
+        // Passage row: every set keeps at least one connection downwards
+        std::fill(remaining.begin(), remaining.end(), 0);
+        std::fill(hasDown.begin(), hasDown.end(), 0);
+        for (int c = 0; c < cells; c++) {
+            remaining[sets[c]]++;
+        }
+        std::fill(row.begin(), row.end(), WALL);
+        for (int c = 0; c < cells; c++) {
+            int set = sets[c];
+            remaining[set]--;
+            down[c] = rng.next() >> 63 || (remaining[set] == 0 && !hasDown[set]);
+            if (down[c]) {
+                hasDown[set] = 1;
+                row[2 * c + 1] = PATH;
+            }
+        }
+        sink.writeRow(2 * r + 2, row.data());
+
+        relabel();
+    }
+
+    // Bottom outer wall with the finishing point
+    std::fill(row.begin(), row.end(), WALL);
+    row[size - 2] = END;
+    sink.writeRow(size - 1, row.data());
+
+    sink.endMaze();
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MazeFile.h"
+#include "MazeGrid.h"
+#include "Random.h"
+
+/**
+ * @class MazeRowSink
+ * @brief Receiver of maze rows produced by a streaming generator.
+ */
+class MazeRowSink {
+public:
+    virtual ~MazeRowSink() { }
+
+    /**
+     * @brief Called once before the first row.
+     *
+     * @param size The size (width and height) of the maze.
+     */
+    virtual void beginMaze(int /*size*/) { }
+
+    /**
+     * @brief Called for every row of the maze in increasing order.
+     *
+     * @param x The row index.
+     * @param row The cells of the row, valid only during the call.
+     */
+    virtual void writeRow(int x, const CellType* row) = 0;
+
+    /**
+     * @brief Called once after the last row.
+     */
+    virtual void endMaze() { }
+};
+
+/**
+ * @class MazeFileSink
+ * @brief Writes rows to a binary maze file as soon as they are generated.
+ *
+ * Each row is packed into one reused row of 64-bit words and written right away, so the file matches
+ * saveMazeFile() bit for bit while only one row is ever held in memory.
+ */
+class MazeFileSink : public MazeRowSink {
+public:
+    /**
+     * @brief Constructor for MazeFileSink.
+     *
+     * @param path Path of the file to write.
+     * @param info Description of the maze, its size is taken from beginMaze().
+     */
+    MazeFileSink(const std::string& path, const MazeFileInfo& info);
+
+    virtual void beginMaze(int size);
+    virtual void writeRow(int x, const CellType* row);
+    virtual void endMaze();
+
+    /**
+     * @brief Checks whether the whole maze reached the file.
+     *
+     * @return bool - True once endMaze() closed a file that was written without errors, false otherwise.
+     */
+    bool isWritten() const;
+
+    /**
+     * @brief Gets the memory held by the row buffer.
+     *
+     * @return size_t - Bytes of the packed row, proportional to the width of the maze.
+     */
+    size_t getMemoryUsage() const;
+
+protected:
+    std::string path; // Path of the file to write
+    MazeFileInfo info; // Description of the maze written to the header
+    std::ofstream file; // The maze file
+    std::vector<uint64_t> words; // Reused packed row
+    bool written; // True once the file was closed without errors
+};
+
+/**
+ * @class EllerGenerator
+ * @brief Generates a perfect maze one row at a time using Eller's algorithm.
+ *
+ * Only the set labels of the current row are kept, so memory is proportional to the width of the maze
+ * and rows are handed to a MazeRowSink as soon as they are complete. The layout follows MazeGenerator:
+ * cells on odd coordinates, START at (1, 1) and END in the last row at (size-1, size-2).
+ */
+class EllerGenerator {
+public:
+    /**
+     * @brief Constructor for EllerGenerator.
+     *
+     * @param size The size (width and height) of the maze, must be odd.
+     * @param seed The seed of the random joins, the same seed always gives the same maze.
+     */
+    EllerGenerator(int size, uint64_t seed);
+
+    /**
+     * @brief Generates the maze and streams its rows to the sink.
+     *
+     * @param sink The receiver of the rows.
+     */
+    void generate(MazeRowSink& sink);
+
+    /**
+     * @brief Gets the memory held by the row state.
+     *
+     * @return size_t - Bytes used by the set labels and row buffers, proportional to the width of the maze.
+     */
+    size_t getMemoryUsage() const;
+
+protected:
+    int size; // The size (width and height) of the maze
+    int cells; // Number of cells per row, (size-1)/2
+    Random rng; // Generator of the random joins
+    std::vector<int> sets; // Set label of every cell in the current row
+    std::vector<int> parent; // Union-find forest over set labels, 2*cells labels
+    std::vector<int> remaining; // Members of a set not yet visited in the vertical pass
+    std::vector<unsigned char> hasDown; // Whether a set already got a downward passage
+    std::vector<unsigned char> down; // Downward passages of the current row
+    std::vector<CellType> row; // Row buffer handed to the sink
+
+    /**
+     * @brief Finds the representative label of a set.
+     *
+     * @param label A set label.
+     * @return int - The representative label.
+     */
+    int find(int label);
+
+    /**
+     * @brief Assigns fresh labels to the cells without a passage from the previous row.
+     */
+    void relabel();
+};
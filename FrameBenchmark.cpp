@@ -0,0 +1,153 @@
+#include "FrameBenchmark.h"
+
+FrameBenchmark::FrameBenchmark(osgViewer::ViewerBase& viewer, const std::vector<CameraController*>& controllers,
+                               const std::vector<std::pair<int, int>>& path):
+    viewer(viewer),
+    controllers(controllers),
+    path(path) { }
+
+bool FrameBenchmark::setUpOffscreen(osgViewer::Viewer& viewer) {
+    osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+    traits->x = 0;
+    traits->y = 0;
+    traits->width = BENCH_WIDTH;
+    traits->height = BENCH_HEIGHT;
+    traits->windowDecoration = false;
+    traits->doubleBuffer = false;
+    traits->pbuffer = true;
+
+    osg::ref_ptr<osg::GraphicsContext> context = osg::GraphicsContext::createGraphicsContext(traits.get());
+    if (!context.valid()) {
+        std::cerr << "Cannot create an offscreen graphics context" << std::endl;
+        return false;
+    }
+
+    osg::Camera* camera = viewer.getCamera();
+    camera->setGraphicsContext(context.get());
+    camera->setViewport(new osg::Viewport(0, 0, BENCH_WIDTH, BENCH_HEIGHT));
+    camera->setProjectionMatrixAsPerspective(30.0, static_cast<double>(BENCH_WIDTH) / BENCH_HEIGHT, 0.1, 1000.0);
+    camera->setDrawBuffer(GL_FRONT);
+    camera->setReadBuffer(GL_FRONT);
+
+    enableTraversalStats(camera);
+    viewer.setThreadingModel(osgViewer::Viewer::SingleThreaded);
+    return true;
+}
+
+void FrameBenchmark::enableTraversalStats(osg::Camera* camera) {
+    // Cull and draw times are only recorded while stats collection is on
+    camera->getStats()->collectStats("rendering", true);
+}
+
+TraversalTimes FrameBenchmark::sampleTraversalTimes(osgViewer::ViewerBase& viewer, const std::vector<CameraController*>& controllers,
+                                                    std::vector<double>& cullTimes, std::vector<double>& drawTimes) {
+    // Traversal times are stored in seconds per camera. The threaded models may still be drawing the frame
+    // just started, so read the previous one, which frame() has always waited for
+    unsigned frameNumber = viewer.getViewerFrameStamp()->getFrameNumber() - 1;
+    TraversalTimes times;
+    for (CameraController* controller : controllers) {
+        osg::Stats* stats = controller->getView()->getCamera()->getStats();
+        double cullTime = 0.0, drawTime = 0.0;
+        if (stats->getAttribute(frameNumber, "Cull traversal time taken", cullTime)) {
+            times.cull += cullTime * 1000.0;
+            times.culled = true;
+        }
+        if (stats->getAttribute(frameNumber, "Draw traversal time taken", drawTime)) {
+            times.draw += drawTime * 1000.0;
+            times.drawn = true;
+        }
+    }
+    if (times.culled) {
+        cullTimes.push_back(times.cull);
+    }
+    if (times.drawn) {
+        drawTimes.push_back(times.draw);
+    }
+    return times;
+}
+
+void FrameBenchmark::run() {
+    double length = path.size() > 1 ? static_cast<double>(path.size() - 1) : 0.0;
+    double speed = std::max(BENCH_SPEED, length / BENCH_MAX_FRAMES);
+
+    frameTimes.clear();
+    cullTimes.clear();
+    drawTimes.clear();
+
+    int frame = 0;
+    for (double distance = 0.0; !viewer.done() && !controllers[0]->checkExit(); distance += speed, frame++) {
+        for (size_t i = 0; i < controllers.size(); i++) {
+            // Look slightly ahead along the path so the camera turns smoothly at corners
+            double viewDistance = std::max(0.0, distance - BENCH_VIEW_SPACING * i);
+            osg::Vec3d eye = getPathPoint(viewDistance);
+            osg::Vec3d center = getPathPoint(viewDistance + BENCH_LOOK_AHEAD);
+            if ((center - eye).length2() < 1e-6) {
+                center = eye + osg::Vec3d(1.0, 0.0, 0.0);
+            }
+            controllers[i]->setTransformation(eye, center, osg::Vec3d(0.0, 0.0, 1.0));
+        }
+
+        osg::Timer_t startTick = osg::Timer::instance()->tick();
+        viewer.frame();
+        osg::Timer_t endTick = osg::Timer::instance()->tick();
+
+        if (frame < BENCH_WARMUP_FRAMES) {
+            continue;
+        }
+        frameTimes.push_back(osg::Timer::instance()->delta_m(startTick, endTick));
+
+        sampleTraversalTimes(viewer, controllers, cullTimes, drawTimes);
+
+        // Past the last cell the camera stands still, stop if the exit was never detected
+        if (distance > length + 1.0) {
+            std::cerr << "Benchmark camera did not reach the exit" << std::endl;
+            break;
+        }
+    }
+}
+
+void FrameBenchmark::printReport(int mazeSize, uint64_t seed) const {
+    std::vector<double> sorted(frameTimes);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::cout << "maze_size,seed,path_cells,frames,p50_ms,p90_ms,p99_ms,max_ms,cull_mean_ms,draw_mean_ms,views" << std::endl;
+    std::cout << mazeSize << "," << seed << "," << path.size() << "," << sorted.size() << ","
+              << getPercentile(sorted, 50.0) << "," << getPercentile(sorted, 90.0) << ","
+              << getPercentile(sorted, 99.0) << "," << (sorted.empty() ? 0.0 : sorted.back()) << ","
+              << getMean(cullTimes) << "," << getMean(drawTimes) << "," << controllers.size() << std::endl;
+}
+
+osg::Vec3d FrameBenchmark::getPathPoint(double distance) const {
+    if (path.empty()) {
+        return osg::Vec3d(0.0, 0.0, zPos);
+    }
+
+    // Consecutive path cells are one unit apart, so the distance maps directly to a segment
+    size_t segment = static_cast<size_t>(std::max(0.0, distance));
+    if (segment + 1 >= path.size()) {
+        return osg::Vec3d(path.back().first, path.back().second, zPos);
+    }
+    double t = distance - static_cast<double>(segment);
+    const std::pair<int, int>& a = path[segment];
+    const std::pair<int, int>& b = path[segment + 1];
+    return osg::Vec3d(a.first + (b.first - a.first) * t, a.second + (b.second - a.second) * t, zPos);
+}
+
+double FrameBenchmark::getPercentile(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+double FrameBenchmark::getMean(const std::vector<double>& samples) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    return sum / static_cast<double>(samples.size());
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <osg/GraphicsContext>
+#include <osg/Stats>
+#include <osg/Timer>
+#include <osg/Viewport>
+#include <osgViewer/Viewer>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "CameraController.h"
+
+#define BENCH_WIDTH 800 // Width of the offscreen framebuffer
+#define BENCH_HEIGHT 600 // Height of the offscreen framebuffer
+#define BENCH_SPEED 0.05 // Minimum distance in cells the camera travels per frame
+#define BENCH_MAX_FRAMES 3000 // The camera speeds up so that the whole path fits in this many frames
+#define BENCH_WARMUP_FRAMES 10 // Frames excluded from the statistics
+#define BENCH_LOOK_AHEAD 0.75 // Distance along the path the camera looks ahead, smooths the turns
+#define BENCH_VIEW_SPACING 8.0 // Distance in cells between the cameras of consecutive views along the path
+
+/**
+ * @struct TraversalTimes
+ * @brief Cull and draw times of one frame summed over the sampled cameras.
+ */
+struct TraversalTimes {
+    double cull = 0.0; // Cull traversal time in ms
+    double draw = 0.0; // Draw traversal time in ms
+    bool culled = false; // True if any camera recorded a cull time
+    bool drawn = false; // True if any camera recorded a draw time
+};
+
+/**
+ * @class FrameBenchmark
+ * @brief Renders a scripted flythrough of the maze offscreen and reports frame, cull and draw times.
+ *
+ * The camera follows the solved path from START to END through the CameraController, so the same
+ * event handling, exit detection and culling code runs as when a player walks through the maze.
+ * With several views every camera trails the previous one by BENCH_VIEW_SPACING cells, so each view
+ * culls and draws a different part of the maze, and the run ends when the first camera reaches the exit.
+ */
+class FrameBenchmark {
+public:
+    /**
+     * @brief Constructor for FrameBenchmark.
+     *
+     * @param viewer The viewer, an osgViewer::Viewer or CompositeViewer rendering offscreen and realized.
+     * @param controllers The camera controller of every view, the first one leads.
+     * @param path Cells of the path from START to END.
+     */
+    FrameBenchmark(osgViewer::ViewerBase& viewer, const std::vector<CameraController*>& controllers,
+                   const std::vector<std::pair<int, int>>& path);
+
+    /**
+     * @brief Renders into a pbuffer instead of a window.
+     *
+     * @param viewer The viewer to set up, not realized yet.
+     * @return bool - True if an offscreen context was created, false otherwise.
+     */
+    static bool setUpOffscreen(osgViewer::Viewer& viewer);
+
+    /**
+     * @brief Turns on the recording of cull and draw times for a camera.
+     *
+     * @param camera The camera.
+     */
+    static void enableTraversalStats(osg::Camera* camera);
+
+    /**
+     * @brief Reads the cull and draw times of the last finished frame from the cameras of the controllers' views.
+     *
+     * @param viewer The viewer rendering the views.
+     * @param controllers The controllers whose view cameras are summed.
+     * @param cullTimes Receives the summed cull time if any camera recorded one.
+     * @param drawTimes Receives the summed draw time if any camera recorded one.
+     * @return TraversalTimes - The summed times.
+     */
+    static TraversalTimes sampleTraversalTimes(osgViewer::ViewerBase& viewer, const std::vector<CameraController*>& controllers,
+                                               std::vector<double>& cullTimes, std::vector<double>& drawTimes);
+
+    /**
+     * @brief Renders frames until the camera reaches the end of the path.
+     */
+    void run();
+
+    /**
+     * @brief Prints frame-time percentiles and mean cull and draw times summed over the views in CSV format.
+     *
+     * @param mazeSize Size of the benchmarked maze.
+     * @param seed Seed the maze was generated with.
+     */
+    void printReport(int mazeSize, uint64_t seed) const;
+
+    /**
+     * @brief Gets a percentile of the measured frame times.
+     *
+     * @param sorted Sorted frame times.
+     * @param percentile Percentile between 0 and 100.
+     * @return double - The frame time in ms.
+     */
+    static double getPercentile(const std::vector<double>& sorted, double percentile);
+
+    /**
+     * @brief Gets the mean of the given samples.
+     *
+     * @param samples The samples.
+     * @return double - The mean, 0 if there are no samples.
+     */
+    static double getMean(const std::vector<double>& samples);
+
+protected:
+    osgViewer::ViewerBase& viewer; // The viewer rendering the frames
+    std::vector<CameraController*> controllers; // The camera controller of every view
+    std::vector<std::pair<int, int>> path; // Cells of the path from START to END
+    std::vector<double> frameTimes; // Wall-clock time of every measured frame in ms
+    std::vector<double> cullTimes; // Cull traversal time of every measured frame summed over the views in ms
+    std::vector<double> drawTimes; // Draw traversal time of every measured frame summed over the views in ms
+
+    /**
+     * @brief Gets the point at the given distance along the path.
+     *
+     * @param distance Distance from START in cells.
+     * @return osg::Vec3d - The point at camera height.
+     */
+    osg::Vec3d getPathPoint(double distance) const;
+};
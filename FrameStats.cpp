@@ -0,0 +1,135 @@
+#include "FrameStats.h"
+
+SceneCountVisitor::SceneCountVisitor():
+    osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+    nodes(0),
+    drawables(0)
+{
+    setNodeMaskOverride(0xffffffff);
+}
+
+void SceneCountVisitor::apply(osg::Node& node) {
+    nodes++;
+    addTextures(node.getStateSet());
+    traverse(node);
+}
+
+void SceneCountVisitor::apply(osg::Drawable& drawable) {
+    drawables++;
+    addTextures(drawable.getStateSet());
+}
+
+void SceneCountVisitor::addTextures(osg::StateSet* stateSet) {
+    if (!stateSet) {
+        return;
+    }
+    osg::StateAttribute* texture = stateSet->getTextureAttribute(0, osg::StateAttribute::TEXTURE);
+    if (texture) {
+        textures.insert(texture);
+    }
+}
+
+FrameStats::FrameStats(const std::string& path):
+    json(path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0),
+    firstRecord(true),
+    nodes(0),
+    drawables(0),
+    textures(0),
+    residentMemory(0),
+    recordedFrames(0)
+{
+    if (path.empty()) {
+        return;
+    }
+
+    file.open(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Cannot write frame stats to " << path << std::endl;
+        return;
+    }
+    file << (json ? "[\n" : "frame,frame_ms,handle_ms,events,nodes,drawables,textures,rss_kb\n");
+}
+
+FrameStats::~FrameStats() {
+    if (file.is_open() && json) {
+        file << "\n]\n";
+    }
+}
+
+void FrameStats::setUpOverlay(osgViewer::Viewer& viewer) {
+    osg::ref_ptr<osgViewer::StatsHandler> statsHandler = new osgViewer::StatsHandler;
+    statsHandler->setKeyEventTogglesOnScreenStats(STATS_TOGGLE_KEY);
+    statsHandler->setKeyEventPrintsOutStats(toupper(STATS_TOGGLE_KEY));
+
+    // Values are stored per frame in the viewer stats under these names, see recordFrame()
+    statsHandler->addUserStatsLine("Handle", osg::Vec4(0.7f, 0.7f, 1.0f, 1.0f), osg::Vec4(0.7f, 0.7f, 1.0f, 0.5f),
+                                   "Handle time taken", 1.0, true, false, "", "", 0.0);
+    statsHandler->addUserStatsLine("Events", osg::Vec4(1.0f, 0.7f, 0.7f, 1.0f), osg::Vec4(1.0f, 0.7f, 0.7f, 0.5f),
+                                   "Events handled", 1.0, false, false, "", "", 0.0);
+    statsHandler->addUserStatsLine("RSS MB", osg::Vec4(0.7f, 1.0f, 0.7f, 1.0f), osg::Vec4(0.7f, 1.0f, 0.7f, 0.5f),
+                                   "Resident memory", 1.0 / 1024.0, false, false, "", "", 0.0);
+    viewer.addEventHandler(statsHandler.get());
+}
+
+void FrameStats::setScene(osg::Node* root, bool paged) {
+    scene = paged ? root : nullptr;
+    countScene(root);
+}
+
+void FrameStats::countScene(osg::Node* root) {
+    SceneCountVisitor visitor;
+    root->accept(visitor);
+    nodes = visitor.nodes;
+    drawables = visitor.drawables;
+    textures = static_cast<int>(visitor.textures.size());
+}
+
+void FrameStats::recordFrame(osgViewer::Viewer& viewer, CameraController* controller, double frameTime) {
+    double handleTime = 0.0;
+    int events = 0;
+    if (controller) {
+        handleTime = controller->getHandleTime();
+        events = controller->getHandledEvents();
+        controller->resetHandleStats();
+    }
+
+    // Reading /proc costs file I/O and a paged scene is too large to walk every frame, sample both
+    if (recordedFrames % STATS_MEMORY_FRAMES == 0) {
+        residentMemory = getResidentMemory();
+    }
+    if (scene && recordedFrames % STATS_RECOUNT_FRAMES == 0) {
+        countScene(scene.get());
+    }
+    recordedFrames++;
+
+    unsigned frameNumber = viewer.getFrameStamp()->getFrameNumber();
+    osg::Stats* stats = viewer.getViewerStats();
+    stats->setAttribute(frameNumber, "Handle time taken", handleTime);
+    stats->setAttribute(frameNumber, "Events handled", events);
+    stats->setAttribute(frameNumber, "Resident memory", static_cast<double>(residentMemory));
+
+    if (!file.is_open()) {
+        return;
+    }
+
+    // The stream is not flushed per frame, so writing it does not cause the hitches being measured
+    if (json) {
+        file << (firstRecord ? "" : ",\n") << "{\"frame\":" << frameNumber << ",\"frame_ms\":" << frameTime
+             << ",\"handle_ms\":" << handleTime << ",\"events\":" << events << ",\"nodes\":" << nodes
+             << ",\"drawables\":" << drawables << ",\"textures\":" << textures << ",\"rss_kb\":" << residentMemory << "}";
+    } else {
+        file << frameNumber << "," << frameTime << "," << handleTime << "," << events << "," << nodes << ","
+             << drawables << "," << textures << "," << residentMemory << "\n";
+    }
+    firstRecord = false;
+}
+
+long FrameStats::getResidentMemory() {
+    // Second field of /proc/self/statm is the resident set size in pages
+    std::ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <osg/Geode>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Stats>
+#include <osg/Texture>
+#include <osgViewer/Viewer>
+#include <osgViewer/ViewerEventHandlers>
+
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <unistd.h>
+
+#include "CameraController.h"
+
+#define STATS_TOGGLE_KEY 'i' // Cycles the on-screen stats, the default 's' key moves the camera
+#define STATS_MEMORY_FRAMES 30 // Frames between two reads of the resident memory
+#define STATS_RECOUNT_FRAMES 60 // Frames between two recounts of a scene the DatabasePager changes
+
+/**
+ * @class SceneCountVisitor
+ * @brief Counts the nodes, drawables and distinct textures of a scene graph.
+ */
+class SceneCountVisitor : public osg::NodeVisitor {
+public:
+    /**
+     * @brief Constructor for SceneCountVisitor, visits all children regardless of node masks.
+     */
+    SceneCountVisitor();
+
+    virtual void apply(osg::Node& node);
+    virtual void apply(osg::Drawable& drawable);
+
+    int nodes; // Number of visited nodes that are not drawables
+    int drawables; // Number of visited drawables
+    std::set<const osg::StateAttribute*> textures; // Distinct textures bound to unit 0
+
+protected:
+    /**
+     * @brief Records the texture bound by the specified StateSet.
+     *
+     * @param stateSet The StateSet to check, may be null.
+     */
+    void addTextures(osg::StateSet* stateSet);
+};
+
+/**
+ * @class FrameStats
+ * @brief Per-frame instrumentation of the main loop.
+ *
+ * Each frame records the frame time, the time CameraController::handle took, the number of handled
+ * events, the scene node, drawable and texture counts and the resident memory. The memory is read every
+ * STATS_MEMORY_FRAMES frames and the scene is counted when it is set, or every STATS_RECOUNT_FRAMES frames
+ * while paging, so the records repeat the last values in between. The records stream to
+ * a CSV file, or to a JSON array when the path ends with ".json", and the handler values are also
+ * published as viewer stats so they show up in the osgViewer::StatsHandler overlay.
+ */
+class FrameStats {
+public:
+    /**
+     * @brief Constructor for FrameStats.
+     *
+     * @param path File to stream the records to, empty to only feed the overlay.
+     */
+    FrameStats(const std::string& path);
+
+    /**
+     * @brief Destructor for FrameStats, terminates the JSON array.
+     */
+    ~FrameStats();
+
+    /**
+     * @brief Adds a StatsHandler with lines for the handler time, event count and resident memory.
+     *
+     * @param viewer The viewer to add the overlay to.
+     */
+    void setUpOverlay(osgViewer::Viewer& viewer);
+
+    /**
+     * @brief Recounts the scene, called whenever the scene graph changes.
+     *
+     * Walking the whole graph takes milliseconds on large mazes, so it is not done every frame.
+     *
+     * @param root Root node of the scene.
+     * @param paged Whether the DatabasePager changes the scene, which is then recounted every STATS_RECOUNT_FRAMES frames.
+     */
+    void setScene(osg::Node* root, bool paged = false);
+
+    /**
+     * @brief Records the frame that was just rendered.
+     *
+     * @param viewer The viewer that rendered the frame.
+     * @param controller The camera controller to read and reset the handler counters of, may be null.
+     * @param frameTime Wall-clock time of the frame in milliseconds.
+     */
+    void recordFrame(osgViewer::Viewer& viewer, CameraController* controller, double frameTime);
+
+protected:
+    std::ofstream file; // Output file, closed if no path was given
+    bool json; // True to write a JSON array, false to write CSV
+    bool firstRecord; // True until the first record has been written
+    int nodes; // Scene node count from the last setScene() call
+    int drawables; // Scene drawable count from the last setScene() call
+    int textures; // Distinct texture count from the last setScene() call
+    osg::ref_ptr<osg::Node> scene; // Scene to recount, null unless the DatabasePager changes it
+    long residentMemory; // Resident memory from the last read in kilobytes
+    unsigned recordedFrames; // Number of frames recorded so far
+
+    /**
+     * @brief Counts the nodes, drawables and textures of a scene.
+     *
+     * @param root Root node of the scene.
+     */
+    void countScene(osg::Node* root);
+
+    /**
+     * @brief Gets the resident memory of the process.
+     *
+     * @return long - Resident set size in kilobytes, 0 if it cannot be read.
+     */
+    static long getResidentMemory();
+};
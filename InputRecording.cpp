@@ -0,0 +1,316 @@
+#include "InputRecording.h"
+#include "FrameBenchmark.h"
+
+RecordedPose RecordedPose::fromMatrix(const osg::Matrixd& matrix) {
+    osg::Vec3d position = matrix.getTrans();
+    osg::Quat rotation = matrix.getRotate();
+    double sign = rotation.w() < 0.0 ? -1.0 : 1.0;
+
+    RecordedPose pose;
+    pose.values[0] = std::llround(position.x() * RECORDING_POSITION_SCALE);
+    pose.values[1] = std::llround(position.y() * RECORDING_POSITION_SCALE);
+    pose.values[2] = std::llround(position.z() * RECORDING_POSITION_SCALE);
+    pose.values[3] = std::llround(rotation.x() * sign * RECORDING_ROTATION_SCALE);
+    pose.values[4] = std::llround(rotation.y() * sign * RECORDING_ROTATION_SCALE);
+    pose.values[5] = std::llround(rotation.z() * sign * RECORDING_ROTATION_SCALE);
+    pose.values[6] = std::llround(rotation.w() * sign * RECORDING_ROTATION_SCALE);
+    return pose;
+}
+
+osg::Matrixd RecordedPose::toMatrix() const {
+    osg::Vec3d position(values[0] / RECORDING_POSITION_SCALE, values[1] / RECORDING_POSITION_SCALE,
+                        values[2] / RECORDING_POSITION_SCALE);
+    osg::Quat rotation(values[3] / RECORDING_ROTATION_SCALE, values[4] / RECORDING_ROTATION_SCALE,
+                       values[5] / RECORDING_ROTATION_SCALE, values[6] / RECORDING_ROTATION_SCALE);
+
+    // Rounding the components leaves the quaternion slightly off unit length
+    double length = rotation.length();
+    if (length > 0.0) {
+        rotation /= length;
+    }
+    return osg::Matrixd::rotate(rotation) * osg::Matrixd::translate(position);
+}
+
+int64_t RecordedPose::getError(const RecordedPose& other) const {
+    int64_t error = 0;
+    for (int i = 0; i < 7; i++) {
+        error = std::max(error, values[i] > other.values[i] ? values[i] - other.values[i] : other.values[i] - values[i]);
+    }
+    return error;
+}
+
+InputRecorder::InputRecorder():
+    lastTime(0),
+    hasPose(false),
+    frames(0),
+    bytes(0) { }
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const std::string& recordingPath, const MazeFileInfo& info) {
+    file.open(recordingPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Cannot write recording " << recordingPath << std::endl;
+        return false;
+    }
+    path = recordingPath;
+
+    RecordingHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.size = static_cast<uint32_t>(info.size);
+    header.startX = static_cast<uint32_t>(info.startX);
+    header.startY = static_cast<uint32_t>(info.startY);
+    header.endX = static_cast<uint32_t>(info.endX);
+    header.endY = static_cast<uint32_t>(info.endY);
+    header.seed = info.seed;
+    header.algorithm = info.algorithm;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    lastTime = 0;
+    hasPose = false;
+    frames = 0;
+    bytes = sizeof(header);
+    return static_cast<bool>(file);
+}
+
+void InputRecorder::close() {
+    if (!file.is_open()) {
+        return;
+    }
+    file.close();
+    std::cout << "Recorded " << frames << " frames in " << bytes << " bytes to " << path << std::endl;
+}
+
+void InputRecorder::recordEvent(const osgGA::GUIEventAdapter& ea) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    switch (ea.getEventType()) {
+        case osgGA::GUIEventAdapter::KEYDOWN:
+        case osgGA::GUIEventAdapter::KEYUP: {
+            bool down = ea.getEventType() == osgGA::GUIEventAdapter::KEYDOWN;
+            file.put(static_cast<char>(down ? RECORD_KEY_DOWN : RECORD_KEY_UP));
+            bytes++;
+            writeVarint(static_cast<uint32_t>(ea.getKey()));
+            break;
+        }
+        case osgGA::GUIEventAdapter::FRAME: {
+            int64_t time = std::llround(ea.getTime() * RECORDING_TIME_SCALE);
+            file.put(static_cast<char>(RECORD_FRAME));
+            bytes++;
+            writeSigned(time - lastTime);
+            lastTime = time;
+            frames++;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void InputRecorder::recordPose(const osg::Matrixd& matrix) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    RecordedPose pose = RecordedPose::fromMatrix(matrix);
+    if (hasPose && pose.getError(lastPose) == 0) {
+        return;
+    }
+
+    file.put(static_cast<char>(RECORD_POSE));
+    bytes++;
+    for (int i = 0; i < 7; i++) {
+        writeSigned(pose.values[i] - lastPose.values[i]);
+    }
+    lastPose = pose;
+    hasPose = true;
+}
+
+void InputRecorder::writeVarint(uint64_t value) {
+    char buffer[10];
+    int length = 0;
+    do {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        buffer[length++] = static_cast<char>(value ? byte | 0x80 : byte);
+    } while (value);
+    file.write(buffer, length);
+    bytes += length;
+}
+
+void InputRecorder::writeSigned(int64_t value) {
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+InputReplay::InputReplay():
+    offset(0),
+    time(0),
+    corrections(0) { }
+
+bool InputReplay::open(const std::string& path, MazeFileInfo& info) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Cannot open recording " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    RecordingHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "Invalid recording " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 || header.version != RECORDING_VERSION) {
+        std::cerr << "Invalid recording " << path << std::endl;
+        return false;
+    }
+
+    info.size = static_cast<int>(header.size);
+    info.startX = static_cast<int>(header.startX);
+    info.startY = static_cast<int>(header.startY);
+    info.endX = static_cast<int>(header.endX);
+    info.endY = static_cast<int>(header.endY);
+    info.seed = header.seed;
+    info.algorithm = header.algorithm;
+    if (!isValidMazeInfo(info)) {
+        std::cerr << "Invalid recording " << path << ": bad size, start, end or algorithm" << std::endl;
+        return false;
+    }
+
+    offset = sizeof(header);
+    time = 0;
+    pose = RecordedPose();
+    return true;
+}
+
+void InputReplay::run(osgViewer::Viewer& viewer, CameraController* controller) {
+    frameTimes.clear();
+    cullTimes.clear();
+    drawTimes.clear();
+    corrections = 0;
+
+    std::cout << "frame,time_s,frame_ms,cull_ms,draw_ms,handle_ms,pose_error" << std::endl;
+    int64_t poseError = 0;
+    for (int frame = 0; !viewer.done() && replayFrame(controller, viewer, poseError); frame++) {
+        double handleTime = controller->getHandleTime();
+        controller->resetHandleStats();
+        viewer.getCamera()->setViewMatrix(controller->getInverseMatrix());
+
+        osg::Timer_t startTick = osg::Timer::instance()->tick();
+        viewer.frame();
+        double frameTime = osg::Timer::instance()->delta_m(startTick, osg::Timer::instance()->tick());
+        frameTimes.push_back(frameTime);
+
+        TraversalTimes times = FrameBenchmark::sampleTraversalTimes(viewer, {controller}, cullTimes, drawTimes);
+
+        std::cout << frame << "," << time / RECORDING_TIME_SCALE << "," << frameTime << "," << times.cull << ","
+                  << times.draw << "," << handleTime << "," << poseError << "\n";
+    }
+    std::cout.flush();
+}
+
+void InputReplay::printReport(int mazeSize, uint64_t seed) const {
+    std::vector<double> sorted(frameTimes);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::cout << "maze_size,seed,frames,p50_ms,p90_ms,p99_ms,max_ms,cull_mean_ms,draw_mean_ms,pose_corrections" << std::endl;
+    std::cout << mazeSize << "," << seed << "," << sorted.size() << ","
+              << FrameBenchmark::getPercentile(sorted, 50.0) << "," << FrameBenchmark::getPercentile(sorted, 90.0) << ","
+              << FrameBenchmark::getPercentile(sorted, 99.0) << "," << (sorted.empty() ? 0.0 : sorted.back()) << ","
+              << FrameBenchmark::getMean(cullTimes) << "," << FrameBenchmark::getMean(drawTimes) << ","
+              << corrections << std::endl;
+}
+
+bool InputReplay::replayFrame(CameraController* controller, osgGA::GUIActionAdapter& aa, int64_t& poseError) {
+    bool truncated = false;
+    while (offset < data.size() && !truncated) {
+        unsigned char type = data[offset++];
+        if (type == RECORD_KEY_DOWN || type == RECORD_KEY_UP) {
+            uint64_t key = 0;
+            if (!readVarint(key)) {
+                truncated = true;
+                break;
+            }
+            sendEvent(controller, aa, type == RECORD_KEY_DOWN ? osgGA::GUIEventAdapter::KEYDOWN : osgGA::GUIEventAdapter::KEYUP,
+                      static_cast<int>(static_cast<uint32_t>(key)));
+        } else if (type == RECORD_FRAME) {
+            int64_t delta = 0;
+            if (!readSigned(delta)) {
+                truncated = true;
+                break;
+            }
+            time += delta;
+            sendEvent(controller, aa, osgGA::GUIEventAdapter::FRAME, 0);
+
+            // The pose of the frame follows it directly, without one the camera did not move
+            if (offset < data.size() && data[offset] == RECORD_POSE) {
+                offset++;
+                for (int64_t& value : pose.values) {
+                    int64_t change = 0;
+                    if (!readSigned(change)) {
+                        truncated = true;
+                        break;
+                    }
+                    value += change;
+                }
+                if (truncated) {
+                    break;
+                }
+            }
+
+            poseError = RecordedPose::fromMatrix(controller->getMatrix()).getError(pose);
+            if (poseError > RECORDING_POSE_TOLERANCE) {
+                controller->setByMatrix(pose.toMatrix());
+                corrections++;
+            }
+            return true;
+        } else {
+            std::cerr << "Unknown record type " << static_cast<int>(type) << " at byte " << offset - 1 << std::endl;
+            offset = data.size();
+            return false;
+        }
+    }
+
+    if (truncated) {
+        std::cerr << "Truncated recording" << std::endl;
+        offset = data.size();
+    }
+    return false;
+}
+
+void InputReplay::sendEvent(CameraController* controller, osgGA::GUIActionAdapter& aa,
+                            osgGA::GUIEventAdapter::EventType type, int key) {
+    osg::ref_ptr<osgGA::GUIEventAdapter> event = new osgGA::GUIEventAdapter;
+    event->setEventType(type);
+    event->setKey(key);
+    event->setTime(time / RECORDING_TIME_SCALE);
+    controller->replayEvent(*event, aa);
+}
+
+bool InputReplay::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && offset < data.size(); shift += 7) {
+        unsigned char byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InputReplay::readSigned(int64_t& value) {
+    uint64_t encoded = 0;
+    if (!readVarint(encoded)) {
+        return false;
+    }
+    value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+    return true;
+}
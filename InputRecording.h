@@ -0,0 +1,262 @@
+#pragma once
+
+#include <osg/Matrixd>
+#include <osg/Quat>
+#include <osg/Timer>
+#include <osgGA/GUIEventAdapter>
+#include <osgViewer/Viewer>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "CameraController.h"
+#include "MazeFile.h"
+
+#define RECORDING_MAGIC "MAZEREC1" // First 8 bytes of every recording
+#define RECORDING_VERSION 1 // Current version of the recording layout
+#define RECORDING_TIME_SCALE 1e9 // Event times are stored in nanoseconds
+#define RECORDING_POSITION_SCALE 4096.0 // Camera positions are stored in 1/4096 of a cell
+#define RECORDING_ROTATION_SCALE 32767.0 // Camera rotation quaternion components are stored in 1/32767
+#define RECORDING_POSE_TOLERANCE 1 // Quantization steps a replayed pose may differ from the recorded one
+
+/**
+ * @struct RecordingHeader
+ * @brief On-disk header of an input recording, followed by the record stream.
+ *
+ * All fields are stored in host byte order. The header describes the maze the same way a maze file does,
+ * so the maze can be generated again from the seed and algorithm before the input is replayed.
+ */
+struct RecordingHeader {
+    char magic[8]; // RECORDING_MAGIC
+    uint32_t version; // RECORDING_VERSION
+    uint32_t size; // The size (width and height) of the maze
+    uint32_t startX, startY; // Coordinates of START
+    uint32_t endX, endY; // Coordinates of END
+    uint64_t seed; // Seed the maze was generated with
+    uint32_t algorithm; // MazeAlgorithm the maze was generated with
+    uint32_t reserved; // Zero, reserved for future use
+};
+
+static_assert(sizeof(RecordingHeader) == 48, "RecordingHeader must stay 48 bytes");
+
+/**
+ * @enum RecordType
+ * @brief First byte of every record in the stream.
+ *
+ * FRAME is followed by the zigzag varint of the time since the previous frame in nanoseconds, KEY_DOWN and
+ * KEY_UP by the varint of the key code and POSE by the zigzag varints of the 7 quantized pose components
+ * minus those of the previous pose. A POSE record always directly follows the FRAME it was taken after.
+ */
+enum RecordType {
+    RECORD_FRAME,
+    RECORD_KEY_DOWN,
+    RECORD_KEY_UP,
+    RECORD_POSE
+};
+
+/**
+ * @struct RecordedPose
+ * @brief Camera pose quantized for the recording.
+ */
+struct RecordedPose {
+    int64_t values[7] = {}; // Position x, y, z followed by the rotation quaternion x, y, z, w
+
+    /**
+     * @brief Quantizes the pose of a camera manipulator matrix.
+     *
+     * The quaternion is flipped to a non-negative w, q and -q describe the same rotation.
+     *
+     * @param matrix The camera matrix, the inverse of the view matrix.
+     * @return RecordedPose - The quantized pose.
+     */
+    static RecordedPose fromMatrix(const osg::Matrixd& matrix);
+
+    /**
+     * @brief Rebuilds the camera matrix of the pose.
+     *
+     * @return osg::Matrixd - The camera matrix.
+     */
+    osg::Matrixd toMatrix() const;
+
+    /**
+     * @brief Gets the largest difference of a component to another pose.
+     *
+     * @param other The other pose.
+     * @return int64_t - The difference in quantization steps.
+     */
+    int64_t getError(const RecordedPose& other) const;
+};
+
+/**
+ * @class InputRecorder
+ * @brief Writes the events a CameraController handles and the camera poses they lead to into a compact binary file.
+ *
+ * Only key and FRAME events are stored, they are all the fixed-step movement depends on. Every value is a
+ * varint delta to the previous one, so a frame costs 5 bytes while the camera stands still and about 15 while it moves.
+ */
+class InputRecorder {
+public:
+    /**
+     * @brief Constructor for InputRecorder, nothing is written until open() is called.
+     */
+    InputRecorder();
+
+    /**
+     * @brief Destructor for InputRecorder, closes the file.
+     */
+    ~InputRecorder();
+
+    /**
+     * @brief Creates the recording and writes its header.
+     *
+     * @param path Path of the file to write.
+     * @param info Description of the played maze.
+     * @return bool - True if the file was created, false otherwise.
+     */
+    bool open(const std::string& path, const MazeFileInfo& info);
+
+    /**
+     * @brief Flushes and closes the file and prints the size of the recording.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether the recording is open.
+     *
+     * @return bool - True if events are recorded, false otherwise.
+     */
+    bool isOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Records an event passed to the controller, events other than key and FRAME events are skipped.
+     *
+     * @param ea The GUIEventAdapter containing the event.
+     */
+    void recordEvent(const osgGA::GUIEventAdapter& ea);
+
+    /**
+     * @brief Records the camera pose after a FRAME event, if it changed since the last recorded pose.
+     *
+     * @param matrix The camera matrix.
+     */
+    void recordPose(const osg::Matrixd& matrix);
+
+protected:
+    std::ofstream file; // Output file
+    std::string path; // Path of the output file
+    int64_t lastTime; // Time of the previous FRAME event in nanoseconds
+    RecordedPose lastPose; // The last recorded pose
+    bool hasPose; // True once a pose has been recorded
+    size_t frames; // Number of recorded FRAME events
+    size_t bytes; // Number of bytes written including the header
+
+    /**
+     * @brief Writes an unsigned LEB128 varint.
+     *
+     * @param value The value.
+     */
+    void writeVarint(uint64_t value);
+
+    /**
+     * @brief Writes a signed value as a zigzag varint, small magnitudes of either sign take one byte.
+     *
+     * @param value The value.
+     */
+    void writeSigned(int64_t value);
+};
+
+/**
+ * @class InputReplay
+ * @brief Feeds a recording back through a CameraController and reports the time of every frame.
+ *
+ * The controller is not attached to the viewer as its manipulator, so live input does not reach it. The
+ * recorded events are passed to it with their recorded times before every frame, and the view matrix is set
+ * from it. With the same maze, key events and frame times the fixed-step integration repeats the recorded
+ * movement exactly; mouse rotation is not recorded, so where the camera deviates from the recorded pose by
+ * more than RECORDING_POSE_TOLERANCE it is moved back onto it and the correction is counted.
+ */
+class InputReplay {
+public:
+    /**
+     * @brief Constructor for InputReplay.
+     */
+    InputReplay();
+
+    /**
+     * @brief Reads a recording into memory.
+     *
+     * @param path Path of the recording.
+     * @param info Receives the description of the recorded maze.
+     * @return bool - True if the file is a valid recording, false otherwise.
+     */
+    bool open(const std::string& path, MazeFileInfo& info);
+
+    /**
+     * @brief Renders one frame per recorded frame and prints one CSV line per frame.
+     *
+     * @param viewer The realized viewer, without a camera manipulator.
+     * @param controller The controller to feed, placed at the start of the maze.
+     */
+    void run(osgViewer::Viewer& viewer, CameraController* controller);
+
+    /**
+     * @brief Prints frame-time percentiles, mean cull and draw times and the pose corrections in CSV format.
+     *
+     * @param mazeSize Size of the replayed maze.
+     * @param seed Seed of the replayed maze.
+     */
+    void printReport(int mazeSize, uint64_t seed) const;
+
+protected:
+    std::vector<unsigned char> data; // The whole recording
+    size_t offset; // Read position in data
+    int64_t time; // Time of the current frame in nanoseconds
+    RecordedPose pose; // The recorded pose of the current frame
+    int corrections; // Number of frames the camera had to be moved back onto the recorded pose
+    std::vector<double> frameTimes; // Wall-clock time of every frame in ms
+    std::vector<double> cullTimes; // Cull traversal time of every frame in ms
+    std::vector<double> drawTimes; // Draw traversal time of every frame in ms
+
+    /**
+     * @brief Passes the records of the next frame to the controller and checks the pose it ends up in.
+     *
+     * @param controller The controller to feed.
+     * @param aa The action adapter passed to the controller.
+     * @param poseError Receives the largest difference to the recorded pose in quantization steps.
+     * @return bool - True if a frame was replayed, false at the end of the recording.
+     */
+    bool replayFrame(CameraController* controller, osgGA::GUIActionAdapter& aa, int64_t& poseError);
+
+    /**
+     * @brief Passes one synthetic event to the controller.
+     *
+     * @param controller The controller to feed.
+     * @param aa The action adapter passed to the controller.
+     * @param type The event type.
+     * @param key The key code of key events.
+     */
+    void sendEvent(CameraController* controller, osgGA::GUIActionAdapter& aa, osgGA::GUIEventAdapter::EventType type, int key);
+
+    /**
+     * @brief Reads an unsigned LEB128 varint.
+     *
+     * @param value Receives the value.
+     * @return bool - True if a complete varint was read, false at a truncated end.
+     */
+    bool readVarint(uint64_t& value);
+
+    /**
+     * @brief Reads a zigzag varint.
+     *
+     * @param value Receives the value.
+     * @return bool - True if a complete varint was read, false at a truncated end.
+     */
+    bool readSigned(int64_t& value);
+};
@@ -0,0 +1,31 @@
+#include "LoadingScreen.h"
+
+LoadingScreen::LoadingScreen(): camera(new osg::Camera), text(new osgText::Text) {
+    camera->setProjectionMatrix(osg::Matrix::ortho2D(0, LOADING_SCREEN_WIDTH, 0, LOADING_SCREEN_HEIGHT));
+    camera->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+    camera->setViewMatrix(osg::Matrix::identity());
+    camera->setClearMask(GL_DEPTH_BUFFER_BIT);
+    camera->setRenderOrder(osg::Camera::POST_RENDER);
+    camera->setAllowEventFocus(false);
+
+    text->setCharacterSize(32.0f);
+    text->setAlignment(osgText::Text::CENTER_CENTER);
+    text->setPosition(osg::Vec3(LOADING_SCREEN_WIDTH / 2.0f, LOADING_SCREEN_HEIGHT / 2.0f, 0.0f));
+    text->setDataVariance(osg::Object::DYNAMIC);
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode;
+    geode->addDrawable(text.get());
+    geode->getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+    camera->addChild(geode.get());
+}
+
+osg::Camera* LoadingScreen::getNode() const {
+    return camera.get();
+}
+
+void LoadingScreen::setText(const std::string& newText) {
+    if (newText != currentText) {
+        currentText = newText;
+        text->setText(newText);
+    }
+}
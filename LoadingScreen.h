@@ -0,0 +1,41 @@
+#pragma once
+
+#include <osg/Camera>
+#include <osg/Geode>
+#include <osgText/Text>
+
+#include <string>
+
+#define LOADING_SCREEN_WIDTH 800 // Width of the screen-space projection
+#define LOADING_SCREEN_HEIGHT 600 // Height of the screen-space projection
+
+/**
+ * @class LoadingScreen
+ * @brief Screen-space text shown over the scene while the maze is being built.
+ */
+class LoadingScreen {
+public:
+    /**
+     * @brief Constructor for LoadingScreen, creates the overlay camera and its text.
+     */
+    LoadingScreen();
+
+    /**
+     * @brief Gets the node to add to the scene to show the screen.
+     *
+     * @return osg::Camera* - The overlay camera.
+     */
+    osg::Camera* getNode() const;
+
+    /**
+     * @brief Replaces the displayed text, called from the main loop between frames.
+     *
+     * @param text The text to display.
+     */
+    void setText(const std::string& text);
+
+protected:
+    osg::ref_ptr<osg::Camera> camera; // Overlay camera rendered after the scene
+    osg::ref_ptr<osgText::Text> text; // Displayed progress text
+    std::string currentText; // Last text passed to setText(), avoids rebuilding identical glyphs
+};
@@ -1,5 +1,6 @@
 #include <osgDB/ReadFile>
 #include <osg/Geode>
+#include <osg/DeleteHandler>
 #include <osg/Group>
 #include <osg/Texture2D>
 #include <osg/Geometry>
@@ -7,170 +8,372 @@
 #include <osgText/Text>
 #include <osgGA/TrackballManipulator>
 #include <osgViewer/ViewerEventHandlers>
+#include <osgUtil/IncrementalCompileOperation>
 #include <osg/PositionAttitudeTransform>
 
-#include <random>
 #include <chrono>
 #include <thread>
 
 #include "MazeGenerator.h"
+#include "ParallelMazeGenerator.h"
+#include "MazeAlgorithms.h"
 #include "CameraController.h"
+#include "TextureRegistry.h"
+#include "MazeMeshBuilder.h"
+#include "MazeVisibility.h"
+#include "MazeSolver.h"
+#include "MazeDistanceField.h"
+#include "FrameBenchmark.h"
+#include "FrameStats.h"
+#include "MazeLoader.h"
+#include "LoadingScreen.h"
+#include "MazePager.h"
+#include "MazeOverview.h"
+#include "SplitScreen.h"
+#include "InputRecording.h"
 
-// g++ -o osg Main.cpp MazeGenerator.cpp CameraController.cpp -losgViewer -losgDB -losg -losgGA -losgUtil -lOpenThreads
+// g++ -o osg Main.cpp MazeGenerator.cpp ParallelMazeGenerator.cpp MazeAlgorithms.cpp EllerGenerator.cpp MazeGrid.cpp MazeFile.cpp Random.cpp CameraController.cpp MazeCollision.cpp TextureRegistry.cpp BlockTextures.cpp MazeMeshBuilder.cpp MazeVisibility.cpp MazeSolver.cpp MazeDistanceField.cpp FrameBenchmark.cpp FrameStats.cpp MazeLoader.cpp LoadingScreen.cpp MazePager.cpp MazeOverview.cpp SplitScreen.cpp InputRecording.cpp -losgViewer -losgDB -losg -losgGA -losgUtil -lOpenThreads -pthread
 int MAZE_SIZE = 25; // Default maze size
-#define MAX_MAZE 50 // Maximum maze size
+uint64_t MAZE_SEED = 0; // Seed of the maze generation and the texture choices
+bool SEED_GIVEN = false; // True if the seed was passed on the command line instead of taken from the clock
+bool BENCH_MODE = false; // Render a scripted flythrough offscreen and report frame times instead of playing
+bool CONTINUOUS_MODE = false; // Move on to a larger maze after finding the diamonds instead of exiting
+bool PAGED_MODE = false; // Stream the chunks around the camera instead of building the whole maze
+int GENERATOR_THREADS = 0; // Number of threads of ParallelMazeGenerator, 0 uses all cores
+bool THREADS_GIVEN = false; // True if the number of generator threads was passed on the command line
+MazeAlgorithm GENERATOR_ALGORITHM = ALGORITHM_DFS; // Generation algorithm, the DFS prints the map of small mazes
+bool ALGORITHM_GIVEN = false; // True if the algorithm was passed on the command line
+std::string LOAD_PATH; // Maze file to load instead of generating a maze
+std::string SAVE_PATH; // Maze file to save the generated maze to
+std::string STATS_PATH; // CSV or JSON file to stream per-frame stats to
+int PLAYERS = 1; // Number of players, more than one splits the window between them
+osgViewer::ViewerBase::ThreadingModel THREADING_MODEL = osgViewer::ViewerBase::AutomaticSelection; // Cull and draw threads
+bool THREADING_GIVEN = false; // True if the threading model was passed on the command line
+std::string RECORD_PATH; // Recording to write the input and camera poses of the first maze to
+std::string REPLAY_PATH; // Recording to replay instead of playing
 #define START_X 1 // Starting x-cordinate of player in the maze
 #define START_Y 1 // Starting y-cordinate of player in the maze
+#define NEXT_LEVEL_GROWTH 1.5 // Size factor between consecutive mazes in continuous mode
+#define PAGED_MIN_SIZE 4097 // Mazes from this size on are always streamed, their full mesh does not fit in memory
+#define PRINT_MAX_SIZE 101 // Largest maze whose map the DFS prints to the console
 
 #define WINDOW_X 700
 #define WINDOW_Y 100
 #define WINDOW_WIDTH 800
 #define WINDOW_HEIGHT 600
 #define END_SCREEN_TIME 3 // Amount of seconds to display end screen before exiting
+#define COMPILE_TARGET_FRAME_RATE 60.0 // Frame rate the incremental compile keeps while uploading chunks
+#define RETIRE_FRAMES 3 // Frames a released OSG object is kept before deletion, so no draw in flight still uses it
 
 // Structure to hold the result of maze generation
 struct MazeCreationResult {
     osg::Node* mazeNode; // Root node of the maze
-    std::vector<std::vector<CellType>> mazeVec; // Maze data represented as a 2D vector
+    std::shared_ptr<const MazeGrid> mazeGrid; // Maze data shared with the camera controller
+    int startX; // X-coordinate of the starting point
+    int startY; // Y-coordinate of the starting point
 };
 
-// Texture weights for random texture selection
-std::vector<std::pair<std::string, int>> textureWeights = {
-    {"assets/cobbled_deepslate.png", 200},
-    {"assets/deepslate.png", 400},
-    {"assets/deepslate_coal_ore.png", 60},
-    {"assets/deepslate_copper_ore.png", 40},
-    {"assets/deepslate_iron_ore.png", 30},
-    {"assets/deepslate_gold_ore.png", 20},
-    {"assets/deepslate_lapis_ore.png", 15},
-    {"assets/deepslate_redstone_ore.png", 10},
-    {"assets/deepslate_emerald_ore.png", 7},
-};
-
-#define MAZE_END_TEXTURE "assets/deepslate_diamond_ore.png"
-
 /**
- * @brief Function to get a random texture based on weights.
+ * @brief Generates a new maze, optionally saving it.
  *
- * @param textureWeights Vector of texture-weight pairs.
- * @return std::string - Randomly selected texture path.
+ * @param size Size of the maze.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ * @param seed Seed of the maze.
+ * @param savePath Maze file to write, empty to skip saving.
+ * @return std::shared_ptr<const MazeGrid> - The generated maze.
  */
-std::string getRandomTexture(const std::vector<std::pair<std::string, int>>& textureWeights) {
-    int totalWeight = 0;
-    for (const auto& tex : textureWeights) {
-        totalWeight += tex.second;
+std::shared_ptr<const MazeGrid> generateMaze(int size, int x, int y, uint64_t seed, const std::string& savePath) {
+    if (GENERATOR_ALGORITHM != ALGORITHM_DFS && GENERATOR_ALGORITHM != ALGORITHM_PARALLEL_DFS) {
+        // Policy generators always start in the corner cell (1, 1)
+        return generatePolicyMaze(GENERATOR_ALGORITHM, size, seed, savePath);
     }
-
-    int randomNumber = std::rand() % totalWeight + 1;
-    int cumulativeWeight = 0;
-    for (const auto& tex : textureWeights) {
-        cumulativeWeight += tex.second;
-        if (randomNumber <= cumulativeWeight) {
-            return tex.first;
+    if (GENERATOR_ALGORITHM == ALGORITHM_PARALLEL_DFS) {
+        // Tiled generation always starts in the corner cell (1, 1), the maze does not depend on the thread count
+        ParallelMazeGenerator maze(size, seed, static_cast<unsigned>(GENERATOR_THREADS));
+        if (!savePath.empty() && !maze.saveMaze(savePath)) {
+            std::cerr << "Cannot write maze file " << savePath << std::endl;
         }
+        return maze.getMaze();
     }
 
-    return "";
+    MazeGenerator maze(size, x, y, seed, size <= PRINT_MAX_SIZE);
+    if (!savePath.empty() && !maze.saveMaze(savePath)) {
+        std::cerr << "Cannot write maze file " << savePath << std::endl;
+    }
+    return maze.getMaze();
 }
 
 /**
- * @brief Creates a floor geometry with the specified texture.
+ * @brief Computes the size of the maze following one of the given size in continuous mode.
  *
- * @param texturePath Path to the texture for the floor.
- * @return osg::Geode* - Pointer to the created floor geometry.
+ * @param size Size of the current maze.
+ * @return int - Size of the next maze, odd and at most MAX_MAZE.
  */
-osg::Geode* createFloor(std::string texturePath) {
-    static osg::ref_ptr<osg::Geode> floorPlane;
-    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-    texture->setImage(osgDB::readImageFile(texturePath));
-    
-    osg::ref_ptr<osg::Drawable> drawable = osg::createTexturedQuadGeometry(osg::Vec3(-0.5f,-0.5f, 0.0f), osg::X_AXIS, osg::Y_AXIS );
-    drawable->getOrCreateStateSet()->setTextureAttributeAndModes(0, texture.get());
-    
-    floorPlane = new osg::Geode;
-    floorPlane->addDrawable(drawable.get());
-
-    return floorPlane.get();
+int getNextLevelSize(int size) {
+    int next = std::min(static_cast<int>(size * NEXT_LEVEL_GROWTH), MAX_MAZE);
+    return next % 2 == 0 ? next + 1 : next;
 }
 
 /**
- * @brief Creates a wall geometry with the specified texture.
+ * @brief Creates the scene of a maze and returns the result.
  *
- * @param texturePath Path to the texture for the wall.
- * @return osg::Geode* - Pointer to the created wall geometry.
+ * @param mazeGrid The maze to build the scene for.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ * @param textures Registry providing the shared textures.
+ * @param seed Seed of the texture choices.
+ * @return MazeCreationResult - Result of maze creation, including root node and maze data.
  */
-osg::Geode* createWall(std::string texturePath) {
-    static osg::ref_ptr<osg::Geode> wallBox;
-    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D;
-    texture->setImage( osgDB::readImageFile(texturePath));
-    
-    osg::ref_ptr<osg::Drawable> drawable = new osg::ShapeDrawable(new osg::Box(osg::Vec3(0.0f, 0.0f, 0.5f), 1.0f));
-    drawable->getOrCreateStateSet()->setTextureAttributeAndModes(0, texture.get());
-    
-    wallBox = new osg::Geode;
-    wallBox->addDrawable(drawable.get());
+MazeCreationResult createMaze(std::shared_ptr<const MazeGrid> mazeGrid, int x, int y, TextureRegistry& textures, uint64_t seed) {
+    MazeMeshBuilder meshBuilder(mazeGrid, textures, seed);
+    osg::ref_ptr<osg::Group> scn = meshBuilder.buildMaze();
+    meshBuilder.printStats();
+    textures.printStats();
 
-    return wallBox.get();
+    // Draw only the chunks that can be seen from the camera's chunk
+    std::shared_ptr<MazeVisibility> visibility = std::make_shared<MazeVisibility>(mazeGrid);
+    scn->setCullCallback(new VisibilityCullCallback(visibility));
+    visibility->printStats();
+
+    MazeCreationResult result;
+    result.mazeNode = scn.release();
+    result.mazeGrid = mazeGrid;
+    result.startX = x;
+    result.startY = y;
+
+    return result;
 }
 
 /**
- * @brief Creates a maze and returns the result.
+ * @brief Creates the streamed scene of a maze through MazeLoader and MazePager, waiting until it is in place.
  *
- * @param size Size of the maze.
+ * Only the paged tile tree is built up front, the DatabasePager builds the chunks around the camera while frames render.
+ *
+ * @param mazeGrid The maze to build the scene for.
  * @param x X-coordinate of the starting point.
  * @param y Y-coordinate of the starting point.
+ * @param endX X-coordinate of the exit.
+ * @param endY Y-coordinate of the exit.
+ * @param textures Registry providing the shared textures.
+ * @param loader Receives the loader, which owns the pager and has to outlive the scene.
  * @return MazeCreationResult - Result of maze creation, including root node and maze data.
  */
-MazeCreationResult createMaze(int size, int x, int y) {
-    MazeGenerator maze(size, x, y);
-    std::vector<std::vector<CellType>> mazeVec = maze.getMaze();
-
-    osg::ref_ptr<osg::Group> scn = new osg::Group;
-    for (int i=0; i<size; i++) {
-        for (int j=0; j<size; j++) {
-            osg::ref_ptr<osg::MatrixTransform> t = new osg::MatrixTransform;
-            t->setMatrix(osg::Matrix::translate(i, j, 0.0f));
-            scn->addChild(t.get());
-            if (mazeVec[i][j] == WALL) {
-                t->addChild(createWall(getRandomTexture(textureWeights)));
-            } else if (mazeVec[i][j] == END) {
-                t->addChild(createWall(MAZE_END_TEXTURE));
-            } else {
-                t->addChild(createFloor(getRandomTexture(textureWeights)));
-            }
-        }
+MazeCreationResult createPagedMaze(std::shared_ptr<const MazeGrid> mazeGrid, int x, int y, int endX, int endY,
+                                   TextureRegistry& textures, std::unique_ptr<MazeLoader>& loader) {
+    loader.reset(new MazeLoader(mazeGrid->getSize(), endX, endY, textures, MAZE_SEED, nullptr, true));
+    loader->start([mazeGrid]() { return mazeGrid; }, x, y);
+    while (!loader->update()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
-    MazeCreationResult result;
-    result.mazeNode = scn.release();
-    result.mazeVec = mazeVec;
+    loader->printStats();
 
+    MazeCreationResult result;
+    result.mazeNode = loader->getChunkGroup();
+    result.mazeGrid = mazeGrid;
+    result.startX = x;
+    result.startY = y;
     return result;
 }
 
 /**
- * @brief Sets up the viewer with the specified root, controller, and maze result.
+ * @brief Parses the name of a viewer threading model.
+ *
+ * @param name auto, single, cull-draw, draw or cull-camera.
+ * @param model Receives the threading model.
+ * @return bool - True if the name is known, false otherwise.
+ */
+bool parseThreadingModel(const std::string& name, osgViewer::ViewerBase::ThreadingModel& model) {
+    if (name == "auto") {
+        model = osgViewer::ViewerBase::AutomaticSelection;
+    } else if (name == "single") {
+        model = osgViewer::ViewerBase::SingleThreaded;
+    } else if (name == "cull-draw") {
+        model = osgViewer::ViewerBase::CullDrawThreadPerContext;
+    } else if (name == "draw") {
+        model = osgViewer::ViewerBase::DrawThreadPerContext;
+    } else if (name == "cull-camera") {
+        model = osgViewer::ViewerBase::CullThreadPerCameraDrawThreadPerContext;
+    } else {
+        std::cerr << "Unknown threading model " << name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens the window and shows the scene while the maze is still being built.
  *
  * @param viewer osgViewer::Viewer reference.
  * @param root Root node of the scene.
- * @param controller Reference to the camera controller.
- * @param maze MazeCreationResult& - Result of maze creation.
+ * @param compileOperation Uploads the chunks across frames as they are built.
  */
-void setupViewer(osgViewer::Viewer& viewer, osg::Group* root, CameraController*& controller, MazeCreationResult& maze) {
+void setupViewer(osgViewer::Viewer& viewer, osg::Group* root, osgUtil::IncrementalCompileOperation* compileOperation) {
     viewer.setSceneData(root);
     viewer.setUpViewInWindow(WINDOW_X, WINDOW_Y, WINDOW_WIDTH, WINDOW_HEIGHT);
+    viewer.setThreadingModel(THREADING_MODEL);
+    viewer.realize();
+    viewer.setIncrementalCompileOperation(compileOperation);
+    viewer.getDatabasePager()->setTargetMaximumNumberOfPageLOD(PAGED_MAX_RESIDENT);
+}
+
+/**
+ * @brief Starts building the loaded maze, or generating a new one, in the background.
+ *
+ * @param loader The loader of the first maze.
+ * @param mazeGrid The maze loaded from a file, null to generate one.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ */
+void startLoader(MazeLoader& loader, std::shared_ptr<const MazeGrid> mazeGrid, int x, int y) {
+    if (mazeGrid) {
+        loader.start([mazeGrid]() { return mazeGrid; }, x, y);
+    } else {
+        loader.start([]() { return generateMaze(MAZE_SIZE, START_X, START_Y, MAZE_SEED, SAVE_PATH); }, x, y);
+    }
+}
+
+/**
+ * @brief Decides whether a maze is streamed by MazePager or built in full.
+ *
+ * @param size The size (width and height) of the maze.
+ * @return bool - True if the maze is streamed, false otherwise.
+ */
+bool isPaged(int size) {
+    return PAGED_MODE || size >= PAGED_MIN_SIZE;
+}
 
-    controller = new CameraController(&viewer, maze.mazeVec);
-    controller->setInitCamPos(START_X, START_Y);
+/**
+ * @brief Hands the camera to the player once the maze grid exists.
+ *
+ * @param viewer osgViewer::Viewer reference.
+ * @param mazeGrid The maze grid.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ * @return CameraController* - The controller attached to the viewer.
+ */
+CameraController* setupController(osgViewer::Viewer& viewer, std::shared_ptr<const MazeGrid> mazeGrid, int x, int y) {
+    CameraController* controller = new CameraController(&viewer, mazeGrid);
+    controller->setInitCamPos(x, y);
     viewer.setCameraManipulator(controller);
+    return controller;
+}
+
+/**
+ * @brief Gives every view of the split screen its own controller, all sharing the maze grid.
+ *
+ * @param splitScreen The split screen.
+ * @param mazeGrid The maze grid.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ * @return std::vector<CameraController*> - The controllers in view order, each with the keys of its player.
+ */
+std::vector<CameraController*> setupControllers(SplitScreen& splitScreen, std::shared_ptr<const MazeGrid> mazeGrid, int x, int y) {
+    std::vector<CameraController*> controllers;
+    for (int i = 0; i < splitScreen.getNumViews(); i++) {
+        CameraController* controller = new CameraController(splitScreen.getView(i), mazeGrid, playerKeys[i]);
+        controller->setInitCamPos(x, y);
+        splitScreen.setController(i, controller);
+        controllers.push_back(controller);
+    }
+    return controllers;
+}
+
+/**
+ * @brief Flies the camera along the solved path offscreen and prints the frame-time report.
+ *
+ * @param root Root node of the scene.
+ * @param maze MazeCreationResult& - Result of maze creation.
+ * @param endX X-coordinate of the exit.
+ * @param endY Y-coordinate of the exit.
+ * @return int - Exit code of the program.
+ */
+int runBenchmark(osg::Group* root, MazeCreationResult& maze, int endX, int endY) {
+    MazeSolver solver(maze.mazeGrid);
+    int size = maze.mazeGrid->getSize();
+    std::vector<std::pair<int, int>> path = solver.findPath(maze.startX, maze.startY, endX, endY);
+    if (path.empty()) {
+        std::cerr << "No path from the start to the exit" << std::endl;
+        return 1;
+    }
+
+    // One view renders through a plain Viewer, several share one pbuffer in a CompositeViewer
+    osgViewer::Viewer viewer;
+    SplitScreen splitScreen(PLAYERS);
+    osgViewer::ViewerBase* benchViewer = &viewer;
+    std::vector<CameraController*> controllers;
+    if (PLAYERS > 1) {
+        if (!splitScreen.setUp(root, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, true)) {
+            return 1;
+        }
+        controllers = setupControllers(splitScreen, maze.mazeGrid, maze.startX, maze.startY);
+        benchViewer = &splitScreen.getViewer();
+        for (int i = 0; i < splitScreen.getNumViews(); i++) {
+            splitScreen.getView(i)->getDatabasePager()->setTargetMaximumNumberOfPageLOD(PAGED_MAX_RESIDENT);
+        }
+    } else {
+        if (!FrameBenchmark::setUpOffscreen(viewer)) {
+            return 1;
+        }
+        viewer.setSceneData(root);
+        viewer.getDatabasePager()->setTargetMaximumNumberOfPageLOD(PAGED_MAX_RESIDENT);
+        controllers.push_back(setupController(viewer, maze.mazeGrid, maze.startX, maze.startY));
+    }
+    benchViewer->setThreadingModel(THREADING_GIVEN ? THREADING_MODEL : osgViewer::ViewerBase::SingleThreaded);
+    benchViewer->realize();
+
+    FrameBenchmark benchmark(*benchViewer, controllers, path);
+    benchmark.run();
+    benchmark.printReport(size, MAZE_SEED);
+    return 0;
+}
+
+/**
+ * @brief Feeds a recording through a controller, in a window or offscreen, and prints the time of every frame.
+ *
+ * @param root Root node of the scene.
+ * @param maze MazeCreationResult& - Result of maze creation.
+ * @param endX X-coordinate of the exit.
+ * @param endY Y-coordinate of the exit.
+ * @param replay The opened recording.
+ * @return int - Exit code of the program.
+ */
+int runReplay(osg::Group* root, MazeCreationResult& maze, int endX, int endY, InputReplay& replay) {
+    osgViewer::Viewer viewer;
+    if (BENCH_MODE) {
+        if (!FrameBenchmark::setUpOffscreen(viewer)) {
+            return 1;
+        }
+    } else {
+        viewer.setUpViewInWindow(WINDOW_X, WINDOW_Y, WINDOW_WIDTH, WINDOW_HEIGHT);
+    }
+    viewer.setSceneData(root);
+    viewer.getDatabasePager()->setTargetMaximumNumberOfPageLOD(PAGED_MAX_RESIDENT);
+    viewer.setThreadingModel(THREADING_GIVEN ? THREADING_MODEL : osgViewer::ViewerBase::SingleThreaded);
     viewer.realize();
+    FrameBenchmark::enableTraversalStats(viewer.getCamera());
+
+    // The controller is not the viewer's manipulator, so only the recorded events move the camera
+    osg::ref_ptr<CameraController> controller = new CameraController(&viewer, maze.mazeGrid);
+    controller->setInitCamPos(maze.startX, maze.startY);
+    if (isPaged(maze.mazeGrid->getSize())) {
+        controller->setDistanceField(std::make_shared<CompactDistanceField>(maze.mazeGrid, endX, endY));
+    } else {
+        controller->setDistanceField(std::make_shared<MazeDistanceField>(maze.mazeGrid, endX, endY));
+    }
+    controller->home(0.0);
+
+    replay.run(viewer, controller.get());
+    replay.printReport(maze.mazeGrid->getSize(), MAZE_SEED);
+    return 0;
 }
 
 /**
  * @brief Switches the viewer to the TrackballManipulator and sets specified home position.
  *
- * @param viewer osgViewer::Viewer reference.
+ * @param viewer osgViewer::View reference, the viewer or one view of the split screen.
  */
-void switchToTrackballManipulator(osgViewer::Viewer& viewer) {
+void switchToTrackballManipulator(osgViewer::View& viewer) {
     osg::ref_ptr<osgGA::TrackballManipulator> trackballManipulator = new osgGA::TrackballManipulator;
     viewer.setCameraManipulator(trackballManipulator);
     trackballManipulator->setHomePosition(  osg::Vec3d(MAZE_SIZE, -10.0, 30.0),
@@ -179,48 +382,370 @@ void switchToTrackballManipulator(osgViewer::Viewer& viewer) {
     viewer.home();
 }
 
+/**
+ * @brief Replaces the scene of the maze with the end scene viewed through the trackball.
+ *
+ * @param root Root node of the scene.
+ * @param scn_1 Scene shown while playing.
+ * @param scn_2 Scene shown after the diamonds are found.
+ * @param loader The loader of the current maze.
+ */
+void showEndScene(osg::Group* root, osg::Group* scn_1, osg::Group* scn_2, MazeLoader& loader) {
+    // From the trackball's distance the whole maze is in view, draw it as one textured quad
+    std::shared_ptr<const MazeOverview> overview = loader.getOverview();
+    if (overview) {
+        scn_2->replaceChild(loader.getChunkGroup(), overview->createLod(loader.getChunkGroup()));
+    }
+    root->replaceChild(scn_1, scn_2);
+}
+
+/**
+ * @brief Plays one maze with several players in a split window until one of them finds the diamonds.
+ *
+ * All views render the same root, so the chunks, the texture array and the grid are shared.
+ *
+ * @param root Root node of the scene.
+ * @param scn_1 Scene shown while playing.
+ * @param scn_2 Scene shown after the diamonds are found.
+ * @param loader The loader of the maze, not started yet.
+ * @param loadingScreen The loading screen, already in the scene.
+ * @param compileOperation Uploads the chunks across frames as they are built.
+ * @param mazeGrid The maze loaded from a file, null to generate one.
+ * @param x X-coordinate of the starting point.
+ * @param y Y-coordinate of the starting point.
+ * @return int - Exit code of the program.
+ */
+int runSplitScreen(osg::Group* root, osg::Group* scn_1, osg::Group* scn_2, MazeLoader& loader, LoadingScreen& loadingScreen,
+                   osgUtil::IncrementalCompileOperation* compileOperation, std::shared_ptr<const MazeGrid> mazeGrid, int x, int y) {
+    SplitScreen splitScreen(PLAYERS);
+    if (!splitScreen.setUp(root, WINDOW_X, WINDOW_Y, WINDOW_WIDTH, WINDOW_HEIGHT, false)) {
+        return 1;
+    }
+    osgViewer::CompositeViewer& viewer = splitScreen.getViewer();
+    viewer.setThreadingModel(THREADING_MODEL);
+    viewer.realize();
+    viewer.setIncrementalCompileOperation(compileOperation);
+    for (int i = 0; i < splitScreen.getNumViews(); i++) {
+        splitScreen.getView(i)->getDatabasePager()->setTargetMaximumNumberOfPageLOD(PAGED_MAX_RESIDENT);
+    }
+    startLoader(loader, mazeGrid, x, y);
+
+    std::vector<CameraController*> controllers;
+    bool loading = true, hints = false, found = false;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    while (!viewer.done()) {
+        viewer.frame();
+
+        // Pick up the results of the background stages
+        if (loading) {
+            if (controllers.empty() && loader.getGrid()) {
+                controllers = setupControllers(splitScreen, loader.getGrid(), x, y);
+            }
+            if (!controllers.empty() && !hints && loader.getDistanceField()) {
+                for (CameraController* controller : controllers) {
+                    controller->setDistanceField(loader.getDistanceField());
+                }
+                hints = true;
+            }
+            loadingScreen.setText(loader.getProgressText());
+            if (loader.update()) {
+                loading = false;
+                root->removeChild(loadingScreen.getNode());
+                loader.printStats();
+            }
+        }
+
+        // The first player to reach the exit wins
+        for (size_t i = 0; i < controllers.size() && !found; i++) {
+            if (controllers[i]->checkExit()) {
+                std::cout << "\n--+> PLAYER " << i + 1 << " FOUND THE DIAMONDS! <+--" << std::endl;
+                found = true;
+                showEndScene(root, scn_1, scn_2, loader);
+                for (int v = 0; v < splitScreen.getNumViews(); v++) {
+                    switchToTrackballManipulator(*splitScreen.getView(v));
+                }
+                startTime = std::chrono::high_resolution_clock::now();
+            }
+        }
+
+        if (found) {
+            auto currentTime = std::chrono::high_resolution_clock::now();
+            if (std::chrono::duration_cast<std::chrono::seconds>(currentTime-startTime).count() >= END_SCREEN_TIME) {
+                viewer.setDone(true);
+            }
+        }
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc > 1) {
-        MAZE_SIZE = std::max(5, std::atoi(argv[1]));
-        MAZE_SIZE = std::min(MAZE_SIZE, MAX_MAZE);
-        if (MAZE_SIZE % 2 == 0) {
-            MAZE_SIZE += 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            GENERATOR_THREADS = std::max(0, std::atoi(argv[++i]));
+            THREADS_GIVEN = true;
+        } else if (arg == "--algorithm" && i + 1 < argc) {
+            if (!parseAlgorithmName(argv[++i], GENERATOR_ALGORITHM)) {
+                return 1;
+            }
+            ALGORITHM_GIVEN = true;
+        } else if (arg == "--load" && i + 1 < argc) {
+            LOAD_PATH = argv[++i];
+        } else if (arg == "--save" && i + 1 < argc) {
+            SAVE_PATH = argv[++i];
+        } else if (arg == "--stats" && i + 1 < argc) {
+            STATS_PATH = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            MAZE_SEED = std::strtoull(argv[++i], nullptr, 10);
+            SEED_GIVEN = true;
+        } else if (arg == "--bench") {
+            BENCH_MODE = true;
+        } else if (arg == "--continuous") {
+            CONTINUOUS_MODE = true;
+        } else if (arg == "--paged") {
+            PAGED_MODE = true;
+        } else if (arg == "--players" && i + 1 < argc) {
+            PLAYERS = std::max(1, std::min(std::atoi(argv[++i]), maxPlayers));
+        } else if (arg == "--threading" && i + 1 < argc) {
+            if (!parseThreadingModel(argv[++i], THREADING_MODEL)) {
+                return 1;
+            }
+            THREADING_GIVEN = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            RECORD_PATH = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            REPLAY_PATH = argv[++i];
+        } else {
+            MAZE_SIZE = std::max(MIN_MAZE, std::atoi(argv[i]));
+            MAZE_SIZE = std::min(MAZE_SIZE, MAX_MAZE);
+            if (MAZE_SIZE % 2 == 0) {
+                MAZE_SIZE += 1;
+            }
         }
     }
 
-    srand(static_cast<unsigned>(time(nullptr)));
+    // The split screen plays a single maze without stats, recording or replay
+    if (PLAYERS > 1 && (CONTINUOUS_MODE || !STATS_PATH.empty() || !RECORD_PATH.empty() || !REPLAY_PATH.empty())) {
+        std::cerr << "--players cannot be combined with --continuous, --stats, --record or --replay" << std::endl;
+        return 1;
+    }
+
+    // --threads selects the parallel generator, whatever number of threads it runs on
+    if (THREADS_GIVEN) {
+        if (ALGORITHM_GIVEN && GENERATOR_ALGORITHM != ALGORITHM_PARALLEL_DFS) {
+            std::cerr << "--threads only applies to the parallel algorithm" << std::endl;
+            return 1;
+        }
+        GENERATOR_ALGORITHM = ALGORITHM_PARALLEL_DFS;
+    }
+
+    // A replay generates the recorded maze again, unless --load gives the maze file
+    InputReplay replay;
+    MazeFileInfo mazeInfo;
+    if (!REPLAY_PATH.empty()) {
+        if (!replay.open(REPLAY_PATH, mazeInfo)) {
+            return 1;
+        }
+        MAZE_SIZE = mazeInfo.size;
+        MAZE_SEED = mazeInfo.seed;
+        SEED_GIVEN = true;
+        GENERATOR_ALGORITHM = static_cast<MazeAlgorithm>(mazeInfo.algorithm);
+    }
+
+    if (!SEED_GIVEN) {
+        MAZE_SEED = static_cast<uint64_t>(time(nullptr));
+    }
+    std::cout << "MAZE SEED: " << MAZE_SEED << " (pass --seed " << MAZE_SEED << " to replay this maze)" << std::endl;
     std::cout << "--+> YOU NEED TO FIND THE DIAMONDS <+--\n" << std::endl;
 
     osg::ref_ptr<osg::Group> root = new osg::Group;
     root->getOrCreateStateSet()->setMode(GL_NORMALIZE, osg::StateAttribute::ON);
     root->getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
 
-    MazeCreationResult maze = createMaze(MAZE_SIZE, START_X, START_Y);
+    std::shared_ptr<const MazeGrid> mazeGrid;
+    int startX = START_X, startY = START_Y;
+    int endX = MAZE_SIZE-1, endY = MAZE_SIZE-2;
+    if (!REPLAY_PATH.empty()) {
+        startX = mazeInfo.startX;
+        startY = mazeInfo.startY;
+        endX = mazeInfo.endX;
+        endY = mazeInfo.endY;
+    }
+    if (!LOAD_PATH.empty()) {
+        MazeFileInfo info;
+        mazeGrid = MazeGenerator::loadMaze(LOAD_PATH, info);
+        if (!mazeGrid) {
+            return 1;
+        }
+        MAZE_SIZE = info.size;
+        MAZE_SEED = info.seed;
+        startX = info.startX;
+        startY = info.startY;
+        endX = info.endX;
+        endY = info.endY;
+        mazeInfo = info;
+    } else {
+        mazeInfo.size = MAZE_SIZE;
+        mazeInfo.startX = startX;
+        mazeInfo.startY = startY;
+        mazeInfo.endX = endX;
+        mazeInfo.endY = endY;
+        mazeInfo.seed = MAZE_SEED;
+        mazeInfo.algorithm = GENERATOR_ALGORITHM;
+    }
+
+    TextureRegistry textures;
+    if (BENCH_MODE || !REPLAY_PATH.empty()) {
+        if (!mazeGrid) {
+            mazeGrid = generateMaze(MAZE_SIZE, START_X, START_Y, MAZE_SEED, SAVE_PATH);
+        }
+        if (!mazeGrid) {
+            return 1;
+        }
+        std::unique_ptr<MazeLoader> pagedLoader; // Owns the pager of a streamed maze until the run ends
+        MazeCreationResult maze = isPaged(MAZE_SIZE) ? createPagedMaze(mazeGrid, startX, startY, endX, endY, textures, pagedLoader)
+                                                     : createMaze(mazeGrid, startX, startY, textures, MAZE_SEED);
+        root->addChild(maze.mazeNode);
+        return REPLAY_PATH.empty() ? runBenchmark(root, maze, endX, endY) : runReplay(root, maze, endX, endY, replay);
+    }
+
+    // Generation, meshing and uploads run in the background while the loading screen is shown
+    osg::ref_ptr<osgUtil::IncrementalCompileOperation> compileOperation = new osgUtil::IncrementalCompileOperation;
+    compileOperation->setTargetFrameRate(COMPILE_TARGET_FRAME_RATE);
+    std::unique_ptr<MazeLoader> loader(new MazeLoader(MAZE_SIZE, endX, endY, textures, MAZE_SEED, compileOperation.get(), isPaged(MAZE_SIZE)));
+    std::unique_ptr<MazeLoader> nextLoader; // Prefetches the next level in continuous mode
+    std::thread retireThread; // Releases the grid and distances of the previous level off the main thread
+    LoadingScreen loadingScreen;
+
     osg::ref_ptr<osg::Group> scn_1 = new osg::Group, scn_2 = new osg::Group;
-    scn_1->addChild(maze.mazeNode);
-    scn_2->addChild(maze.mazeNode);
+    scn_1->addChild(loader->getChunkGroup());
+    scn_2->addChild(loader->getChunkGroup());
     root->addChild(scn_1);
+    root->addChild(loadingScreen.getNode());
+
+    if (PLAYERS > 1) {
+        return runSplitScreen(root, scn_1, scn_2, *loader, loadingScreen, compileOperation.get(), mazeGrid, startX, startY);
+    }
 
     osgViewer::Viewer viewer;
-    CameraController* controller = nullptr;
-    setupViewer(viewer, root, controller, maze);
+    setupViewer(viewer, root, compileOperation.get());
+    startLoader(*loader, mazeGrid, startX, startY);
+
+    // The viewer flushes the handler every frame, so retired levels are deleted between frames on this thread
+    if (CONTINUOUS_MODE) {
+        osg::Referenced::setDeleteHandler(new osg::DeleteHandler(RETIRE_FRAMES));
+    }
 
+    FrameStats frameStats(STATS_PATH);
+    frameStats.setUpOverlay(viewer);
+    frameStats.setScene(root, isPaged(MAZE_SIZE));
+
+    // Records the first maze from the moment the player can walk until the diamonds are found
+    InputRecorder recorder;
+    if (!RECORD_PATH.empty() && !recorder.open(RECORD_PATH, mazeInfo)) {
+        return 1;
+    }
+
+    osg::ref_ptr<CameraController> controller; // Keeps the controller alive once the trackball manipulator replaces it
+    bool loading = true, hints = false;
+    bool nextReady = false;
+    int nextSize = 0;
+    uint64_t level = 0; // Number of mazes completed in continuous mode
     bool found = false;
     auto startTime = std::chrono::high_resolution_clock::now();
     while (!viewer.done()) {
+        osg::Timer_t frameStart = osg::Timer::instance()->tick();
         viewer.frame();
+        double frameTime = osg::Timer::instance()->delta_m(frameStart, osg::Timer::instance()->tick());
+
+        // The controller no longer moves the camera once the trackball manipulator replaces it
+        frameStats.recordFrame(viewer, found && !CONTINUOUS_MODE ? nullptr : controller.get(), frameTime);
+
+        // Pick up the results of the background stages
+        if (loading) {
+            if (!controller && loader->getGrid()) {
+                controller = setupController(viewer, loader->getGrid(), startX, startY);
+                if (recorder.isOpen()) {
+                    controller->setRecorder(&recorder);
+                }
+            }
+            loadingScreen.setText(loader->getProgressText());
+            if (loader->update()) {
+                loading = false;
+                if (!found || !CONTINUOUS_MODE) {
+                    root->removeChild(loadingScreen.getNode());
+                }
+                frameStats.setScene(root, isPaged(MAZE_SIZE));
+                loader->printStats();
+            }
+            // The field is ready at the latest when loading finishes
+            if (controller && !hints && loader->getDistanceField()) {
+                controller->setDistanceField(loader->getDistanceField());
+                hints = true;
+            }
+        }
+
+        // Build the next, larger maze while the current one is played
+        if (CONTINUOUS_MODE && !loading && !nextLoader) {
+            nextSize = getNextLevelSize(MAZE_SIZE);
+            uint64_t nextSeed = mixSeed(MAZE_SEED, level + 1); // Every level of a run is reproducible from --seed
+            nextLoader.reset(new MazeLoader(nextSize, nextSize-1, nextSize-2, textures, nextSeed, compileOperation.get(), isPaged(nextSize)));
+            nextLoader->start([nextSize, nextSeed]() { return generateMaze(nextSize, START_X, START_Y, nextSeed, ""); }, START_X, START_Y);
+            nextReady = false;
+        }
+        if (nextLoader && !nextReady) {
+            nextReady = nextLoader->update();
+        }
 
         // Check if the player has found the diamonds
-        if (!found && controller->checkExit()) {
+        if (!found && controller && controller->checkExit()) {
             std::cout << "\n--+> YOU FOUND THE DIAMONDS! <+--" << std::endl;
             found = true;
-            root->replaceChild(scn_1, scn_2);
-            switchToTrackballManipulator(viewer);
-            startTime = std::chrono::high_resolution_clock::now();
+            controller->setRecorder(nullptr);
+            recorder.close();
+            if (!CONTINUOUS_MODE) {
+                showEndScene(root, scn_1, scn_2, *loader);
+                frameStats.setScene(root, isPaged(MAZE_SIZE));
+                switchToTrackballManipulator(viewer);
+                startTime = std::chrono::high_resolution_clock::now();
+            } else if (!nextReady && !root->containsNode(loadingScreen.getNode())) {
+                root->addChild(loadingScreen.getNode());
+            }
+        }
+
+        // Swap in the prefetched maze, only pointers change so it takes a single frame
+        if (found && CONTINUOUS_MODE) {
+            if (nextReady) {
+                scn_1->replaceChild(loader->getChunkGroup(), nextLoader->getChunkGroup());
+                scn_2->replaceChild(loader->getChunkGroup(), nextLoader->getChunkGroup());
+                controller->setMaze(nextLoader->getGrid(), START_X, START_Y);
+                controller->setDistanceField(nextLoader->getDistanceField()); // Ready, the loader only finishes once it exists
+                hints = true;
+                root->removeChild(loadingScreen.getNode());
+
+                // The old chunks left the scene above, between frames. Freeing a large maze takes a while, so the
+                // loader is deleted on a separate thread; its OSG objects only reach the delete handler there, which
+                // deletes them on the main thread once the draws that may still use them are done.
+                if (retireThread.joinable()) {
+                    retireThread.join();
+                }
+                MazeLoader* retired = loader.release();
+                retireThread = std::thread([retired]() { delete retired; });
+                loader = std::move(nextLoader);
+
+                MAZE_SIZE = nextSize;
+                level++;
+                found = false;
+                frameStats.setScene(root, isPaged(MAZE_SIZE));
+                std::cout << "--+> NEXT MAZE: " << MAZE_SIZE << "x" << MAZE_SIZE << " <+--\n" << std::endl;
+                loader->printStats();
+            } else {
+                loadingScreen.setText(nextLoader ? nextLoader->getProgressText() : loader->getProgressText());
+            }
         }
 
         // Check if the end screen time has elapsed
-        if (found) {
+        if (found && !CONTINUOUS_MODE) {
             auto currentTime = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::seconds>(currentTime-startTime).count();
             if (duration >= END_SCREEN_TIME) {
@@ -229,5 +754,11 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (retireThread.joinable()) {
+        retireThread.join();
+    }
+    if (osg::Referenced::getDeleteHandler()) {
+        osg::Referenced::getDeleteHandler()->flushAll();
+    }
     return 0;
 }
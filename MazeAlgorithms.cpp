@@ -0,0 +1,72 @@
+#include "MazeAlgorithms.h"
+
+constexpr int DfsPolicy::dirX[4];
+constexpr int DfsPolicy::dirY[4];
+
+const char* getAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case ALGORITHM_DFS:
+            return "dfs";
+        case ALGORITHM_PARALLEL_DFS:
+            return "parallel";
+        case ALGORITHM_ELLER:
+            return "eller";
+        case ALGORITHM_KRUSKAL:
+            return "kruskal";
+        case ALGORITHM_PRIM:
+            return "prim";
+        case ALGORITHM_WILSON:
+            return "wilson";
+        case ALGORITHM_BINARY_TREE:
+            return "binarytree";
+    }
+    return "unknown";
+}
+
+bool parseAlgorithmName(const std::string& name, MazeAlgorithm& algorithm) {
+    for (int i = ALGORITHM_DFS; i <= ALGORITHM_BINARY_TREE; i++) {
+        if (name == getAlgorithmName(static_cast<MazeAlgorithm>(i))) {
+            algorithm = static_cast<MazeAlgorithm>(i);
+            return true;
+        }
+    }
+    std::cerr << "Unknown algorithm " << name << std::endl;
+    return false;
+}
+
+/**
+ * @brief Generates and optionally saves a maze with one policy.
+ *
+ * @param size The size (width and height) of the maze.
+ * @param seed The seed of the algorithm.
+ * @param savePath Maze file to write, empty to skip saving.
+ * @return std::shared_ptr<MazeGrid> - The maze.
+ */
+template <class Algorithm>
+std::shared_ptr<MazeGrid> generateWith(int size, uint64_t seed, const std::string& savePath) {
+    PolicyMazeGenerator<Algorithm> generator(size, seed);
+    if (!savePath.empty() && !generator.saveMaze(savePath)) {
+        std::cerr << "Cannot write maze file " << savePath << std::endl;
+    }
+    return generator.getMaze();
+}
+
+std::shared_ptr<MazeGrid> generatePolicyMaze(MazeAlgorithm algorithm, int size, uint64_t seed, const std::string& savePath) {
+    switch (algorithm) {
+        case ALGORITHM_DFS:
+            return generateWith<DfsPolicy>(size, seed, savePath);
+        case ALGORITHM_ELLER:
+            return generateWith<EllerPolicy>(size, seed, savePath);
+        case ALGORITHM_KRUSKAL:
+            return generateWith<KruskalPolicy>(size, seed, savePath);
+        case ALGORITHM_PRIM:
+            return generateWith<PrimPolicy>(size, seed, savePath);
+        case ALGORITHM_WILSON:
+            return generateWith<WilsonPolicy>(size, seed, savePath);
+        case ALGORITHM_BINARY_TREE:
+            return generateWith<BinaryTreePolicy>(size, seed, savePath);
+        default:
+            std::cerr << "Algorithm " << getAlgorithmName(algorithm) << " is not a generation policy" << std::endl;
+            return nullptr;
+    }
+}
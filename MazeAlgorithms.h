@@ -0,0 +1,532 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MazeGrid.h"
+#include "MazeFile.h"
+#include "EllerGenerator.h"
+#include "Random.h"
+
+/*
+ * Generation algorithms as compile-time policies of PolicyMazeGenerator.
+ *
+ * A policy carves a perfect maze into a grid filled with WALL: rooms lie on odd coordinates and are joined
+ * through the passage cell between two of them. Every policy provides
+ *  - static const MazeAlgorithm algorithm, recorded in maze files,
+ *  - void carve(MazeGrid& maze, uint64_t seed), the same seed always giving the same maze,
+ *  - size_t getMemoryUsage() const, the peak working memory of the last carve in bytes, the grid excluded.
+ * PolicyMazeGenerator calls carve() directly, so the inner loops of each policy are compiled into it.
+ */
+
+const int roomDirX[4] = {1, -1, 0, 0}; // Row step of the four directions between rooms
+const int roomDirY[4] = {0, 0, 1, -1}; // Column step of the four directions between rooms
+
+/**
+ * @brief Draws a uniform index that may exceed 32 bits.
+ *
+ * @param rng The random stream.
+ * @param bound The exclusive upper bound, must be positive.
+ * @return uint64_t - A number in [0, bound).
+ */
+inline uint64_t randomIndex(Random& rng, uint64_t bound) {
+    return bound <= 0xFFFFFFFFu ? rng.nextBelow(static_cast<uint32_t>(bound)) : rng.next() % bound;
+}
+
+/**
+ * @brief Opens the cell of a room.
+ *
+ * @param maze The maze grid.
+ * @param i The row of the room.
+ * @param j The column of the room.
+ */
+inline void openRoom(MazeGrid& maze, int i, int j) {
+    maze.set(2 * i + 1, 2 * j + 1, PATH);
+}
+
+/**
+ * @brief Opens the passage cell between two neighbouring rooms.
+ *
+ * @param maze The maze grid.
+ * @param i The row of the first room.
+ * @param j The column of the first room.
+ * @param ni The row of the second room.
+ * @param nj The column of the second room.
+ */
+inline void openPassage(MazeGrid& maze, int i, int j, int ni, int nj) {
+    maze.set(i + ni + 1, j + nj + 1, PATH);
+}
+
+/**
+ * @brief Checks whether a room has been carved.
+ *
+ * @param maze The maze grid.
+ * @param i The row of the room.
+ * @param j The column of the room.
+ * @return bool - True if the cell of the room is open, false otherwise.
+ */
+inline bool isRoomOpen(const MazeGrid& maze, int i, int j) {
+    return maze.get(2 * i + 1, 2 * j + 1) != WALL;
+}
+
+/**
+ * @class DfsPolicy
+ * @brief Randomized depth-first search, the algorithm of MazeGenerator.
+ *
+ * Long winding corridors with few dead ends. The explicit stack holds one 12-byte frame per carved room
+ * in the worst case.
+ */
+class DfsPolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_DFS;
+
+    /**
+     * @brief Constructor for DfsPolicy.
+     *
+     * @param startX The x-coordinate the search starts from.
+     * @param startY The y-coordinate the search starts from.
+     */
+    DfsPolicy(int startX = 1, int startY = 1): startX(startX), startY(startY), memoryUsage(0) { }
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        Random rng(seed);
+        int size = maze.getSize();
+
+        // Explicit DFS stack replacing the recursion, so the depth is bounded by the heap and not by the thread stack
+        std::vector<DfsFrame> stack;
+        stack.push_back(openCell(maze, rng, startX, startY));
+        while (!stack.empty()) {
+            DfsFrame& frame = stack.back();
+            if (frame.next == 4) {
+                stack.pop_back(); // All directions explored -> backtrack
+                continue;
+            }
+
+            int dir = (frame.order >> (2 * frame.next++)) & 3;
+            int newX = frame.x + 2 * dirX[dir];
+            int newY = frame.y + 2 * dirY[dir];
+            bool valid = newX >= 0 && newX < size && newY >= 0 && newY < size && maze.get(newX, newY) == WALL;
+            if (valid && !hasThreeWalls(maze, newX, newY)) {
+                // Carve a path to the new position and continue the generation from there
+                maze.set(frame.x + dirX[dir], frame.y + dirY[dir], PATH);
+                stack.push_back(openCell(maze, rng, newX, newY)); // Invalidates frame
+            }
+        }
+        memoryUsage = stack.capacity() * sizeof(DfsFrame);
+    }
+
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+protected:
+    /**
+     * @struct DfsFrame
+     * @brief One entry of the explicit DFS stack.
+     */
+    struct DfsFrame {
+        int x; // The x-coordinate of the cell
+        int y; // The y-coordinate of the cell
+        unsigned char order; // Randomized direction order, 2 bits per direction
+        unsigned char next; // Index of the next direction to explore
+    };
+
+    static constexpr int dirX[4] = {0, 0, 1, -1}; // Row step of the directions, in the order MazeGenerator used
+    static constexpr int dirY[4] = {1, -1, 0, 0}; // Column step of the directions
+    int startX; // The x-coordinate the search starts from
+    int startY; // The y-coordinate the search starts from
+    size_t memoryUsage; // Peak stack memory of the last carve
+
+    /**
+     * @brief Checks if a cell has at least three open neighbours.
+     */
+    static bool hasThreeWalls(const MazeGrid& maze, int x, int y) {
+        int size = maze.getSize();
+        int walls = 0;
+        walls += x > 0 && maze.get(x - 1, y) == PATH;
+        walls += x < size - 1 && maze.get(x + 1, y) == PATH;
+        walls += y > 0 && maze.get(x, y - 1) == PATH;
+        walls += y < size - 1 && maze.get(x, y + 1) == PATH;
+        return walls >= 3;
+    }
+
+    /**
+     * @brief Marks a cell as a path and prepares its DFS stack frame with a randomized direction order.
+     */
+    static DfsFrame openCell(MazeGrid& maze, Random& rng, int x, int y) {
+        maze.set(x, y, PATH);
+
+        int order[] = {0, 1, 2, 3};
+        for (int i = 0; i < 4; ++i) {
+            int randomIndex = static_cast<int>(rng.nextBelow(4));
+            std::swap(order[i], order[randomIndex]);
+        }
+
+        DfsFrame frame;
+        frame.x = x;
+        frame.y = y;
+        frame.order = static_cast<unsigned char>(order[0] | order[1] << 2 | order[2] << 4 | order[3] << 6);
+        frame.next = 0;
+        return frame;
+    }
+};
+
+/**
+ * @class KruskalPolicy
+ * @brief Randomized Kruskal: joins rooms along the edges of a shuffled list using a flat union-find.
+ *
+ * Short corridors and many dead ends. Needs 4 bytes per room for the forest and 8 bytes per edge.
+ */
+class KruskalPolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_KRUSKAL;
+
+    KruskalPolicy(): memoryUsage(0) { }
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        Random rng(seed);
+        int rooms = (maze.getSize() - 1) / 2;
+        size_t roomCount = static_cast<size_t>(rooms) * rooms;
+
+        // Edge e joins room e/2 with the room below it (even e) or to its right (odd e)
+        std::vector<uint64_t> edges;
+        edges.reserve(2 * roomCount);
+        for (int i = 0; i < rooms; i++) {
+            for (int j = 0; j < rooms; j++) {
+                openRoom(maze, i, j);
+                uint64_t room = static_cast<uint64_t>(i) * rooms + j;
+                if (i + 1 < rooms) {
+                    edges.push_back(2 * room);
+                }
+                if (j + 1 < rooms) {
+                    edges.push_back(2 * room + 1);
+                }
+            }
+        }
+        for (size_t k = edges.size(); k > 1; k--) {
+            std::swap(edges[k - 1], edges[randomIndex(rng, k)]);
+        }
+
+        std::vector<uint32_t> parent(roomCount);
+        std::iota(parent.begin(), parent.end(), 0u);
+        size_t joins = 0;
+        for (size_t k = 0; k < edges.size() && joins + 1 < roomCount; k++) {
+            uint64_t room = edges[k] >> 1;
+            uint64_t other = edges[k] & 1 ? room + 1 : room + rooms;
+            uint32_t a = find(parent, static_cast<uint32_t>(room)), b = find(parent, static_cast<uint32_t>(other));
+            if (a == b) {
+                continue;
+            }
+            parent[b] = a;
+            joins++;
+            openPassage(maze, static_cast<int>(room / rooms), static_cast<int>(room % rooms),
+                        static_cast<int>(other / rooms), static_cast<int>(other % rooms));
+        }
+        memoryUsage = edges.capacity() * sizeof(uint64_t) + parent.capacity() * sizeof(uint32_t);
+    }
+
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+protected:
+    size_t memoryUsage; // Peak edge list and forest memory of the last carve
+
+    /**
+     * @brief Finds the root of a set, halving the path on the way so the forest stays flat.
+     */
+    static uint32_t find(std::vector<uint32_t>& parent, uint32_t room) {
+        while (parent[room] != room) {
+            parent[room] = parent[parent[room]];
+            room = parent[room];
+        }
+        return room;
+    }
+};
+
+/**
+ * @class PrimPolicy
+ * @brief Randomized Prim: grows the maze from one room by attaching a random frontier room at every step.
+ *
+ * Many short dead ends radiating from the start. Needs 1 byte per room of state and the frontier list.
+ */
+class PrimPolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_PRIM;
+
+    PrimPolicy(): memoryUsage(0) { }
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        Random rng(seed);
+        int rooms = (maze.getSize() - 1) / 2;
+        std::vector<unsigned char> inFrontier(static_cast<size_t>(rooms) * rooms);
+        std::vector<uint32_t> frontier;
+
+        // Opens a room and puts its closed neighbours on the frontier
+        auto add = [&](int i, int j) {
+            openRoom(maze, i, j);
+            for (int d = 0; d < 4; d++) {
+                int ni = i + roomDirX[d], nj = j + roomDirY[d];
+                if (ni < 0 || ni >= rooms || nj < 0 || nj >= rooms || isRoomOpen(maze, ni, nj)) {
+                    continue;
+                }
+                size_t index = static_cast<size_t>(ni) * rooms + nj;
+                if (!inFrontier[index]) {
+                    inFrontier[index] = 1;
+                    frontier.push_back(static_cast<uint32_t>(index));
+                }
+            }
+        };
+
+        add(0, 0);
+        while (!frontier.empty()) {
+            size_t k = randomIndex(rng, frontier.size());
+            uint32_t room = frontier[k];
+            frontier[k] = frontier.back();
+            frontier.pop_back();
+
+            // Attach the room to a random neighbour already in the maze
+            int i = static_cast<int>(room / rooms), j = static_cast<int>(room % rooms);
+            int open[4], count = 0;
+            for (int d = 0; d < 4; d++) {
+                int ni = i + roomDirX[d], nj = j + roomDirY[d];
+                if (ni >= 0 && ni < rooms && nj >= 0 && nj < rooms && isRoomOpen(maze, ni, nj)) {
+                    open[count++] = d;
+                }
+            }
+            int d = open[rng.nextBelow(static_cast<uint32_t>(count))];
+            openPassage(maze, i, j, i + roomDirX[d], j + roomDirY[d]);
+            add(i, j);
+        }
+        memoryUsage = inFrontier.capacity() + frontier.capacity() * sizeof(uint32_t);
+    }
+
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+protected:
+    size_t memoryUsage; // Peak state and frontier memory of the last carve
+};
+
+/**
+ * @class WilsonPolicy
+ * @brief Wilson's algorithm: joins rooms to the maze along loop-erased random walks.
+ *
+ * Draws every perfect maze with equal probability. The first walks wander long before they hit the small
+ * initial tree, which makes it the slowest policy on small mazes such as 101x101; on large ones Kruskal is
+ * slower. Needs 1 byte per room for the walk directions.
+ */
+class WilsonPolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_WILSON;
+
+    WilsonPolicy(): memoryUsage(0) { }
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        Random rng(seed);
+        int rooms = (maze.getSize() - 1) / 2;
+        std::vector<unsigned char> walk(static_cast<size_t>(rooms) * rooms);
+
+        openRoom(maze, 0, 0);
+        for (int i = 0; i < rooms; i++) {
+            for (int j = 0; j < rooms; j++) {
+                // Random walk until the maze is hit, a revisited room simply overwrites its direction (loop erasure)
+                int wi = i, wj = j;
+                while (!isRoomOpen(maze, wi, wj)) {
+                    int d, ni, nj;
+                    do {
+                        d = static_cast<int>(rng.nextBelow(4));
+                        ni = wi + roomDirX[d];
+                        nj = wj + roomDirY[d];
+                    } while (ni < 0 || ni >= rooms || nj < 0 || nj >= rooms);
+                    walk[static_cast<size_t>(wi) * rooms + wj] = static_cast<unsigned char>(d);
+                    wi = ni;
+                    wj = nj;
+                }
+
+                // Carve the loop-erased path
+                wi = i;
+                wj = j;
+                while (!isRoomOpen(maze, wi, wj)) {
+                    int d = walk[static_cast<size_t>(wi) * rooms + wj];
+                    openRoom(maze, wi, wj);
+                    openPassage(maze, wi, wj, wi + roomDirX[d], wj + roomDirY[d]);
+                    wi += roomDirX[d];
+                    wj += roomDirY[d];
+                }
+            }
+        }
+        memoryUsage = walk.capacity();
+    }
+
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+protected:
+    size_t memoryUsage; // Walk direction memory of the last carve
+};
+
+/**
+ * @class EllerPolicy
+ * @brief Eller's algorithm row by row through EllerGenerator, memory proportional to the width.
+ */
+class EllerPolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_ELLER;
+
+    EllerPolicy(): memoryUsage(0) { }
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        EllerGenerator generator(maze.getSize(), seed);
+        GridWriter writer(maze);
+        generator.generate(writer);
+        memoryUsage = generator.getMemoryUsage();
+    }
+
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+protected:
+    /**
+     * @class GridWriter
+     * @brief Row sink writing into an existing grid.
+     */
+    class GridWriter : public MazeRowSink {
+    public:
+        GridWriter(MazeGrid& maze): maze(maze) { }
+
+        virtual void writeRow(int x, const CellType* row) {
+            for (int j = 0; j < maze.getSize(); j++) {
+                maze.set(x, j, row[j]);
+            }
+        }
+
+    protected:
+        MazeGrid& maze; // The grid receiving the rows
+    };
+
+    size_t memoryUsage; // Row state memory of the last carve
+};
+
+/**
+ * @class BinaryTreePolicy
+ * @brief Binary tree: every room opens towards the room above or to its left.
+ *
+ * The fastest policy and needs no working memory, but the first row and column are straight corridors
+ * and every path leads diagonally towards the start.
+ */
+class BinaryTreePolicy {
+public:
+    static const MazeAlgorithm algorithm = ALGORITHM_BINARY_TREE;
+
+    void carve(MazeGrid& maze, uint64_t seed) {
+        Random rng(seed);
+        int rooms = (maze.getSize() - 1) / 2;
+        for (int i = 0; i < rooms; i++) {
+            for (int j = 0; j < rooms; j++) {
+                openRoom(maze, i, j);
+                if (i == 0 && j == 0) {
+                    continue;
+                }
+                bool up = j == 0 || (i > 0 && rng.next() >> 63);
+                openPassage(maze, i, j, up ? i - 1 : i, up ? j : j - 1);
+            }
+        }
+    }
+
+    size_t getMemoryUsage() const { return 0; }
+};
+
+/**
+ * @class PolicyMazeGenerator
+ * @brief Generates a maze with the algorithm given as a compile-time policy.
+ *
+ * The layout follows MazeGenerator: START at (1, 1) and END in the last row at (size-1, size-2).
+ */
+template <class Algorithm>
+class PolicyMazeGenerator {
+public:
+    /**
+     * @brief Constructor for PolicyMazeGenerator, generates the maze.
+     *
+     * @param size The size (width and height) of the maze, must be odd.
+     * @param seed The seed of the algorithm, the same seed always gives the same maze.
+     * @param policy The algorithm instance, for policies taking parameters.
+     */
+    PolicyMazeGenerator(int size, uint64_t seed, const Algorithm& policy = Algorithm()):
+        size(size),
+        seed(seed),
+        policy(policy),
+        maze(std::make_shared<MazeGrid>(size, WALL))
+    {
+        this->policy.carve(*maze, seed);
+        maze->set(1, 1, START);
+        maze->set(size-1, size-2, END);
+    }
+
+    /**
+     * @brief Gets the generated maze.
+     *
+     * @return std::shared_ptr<MazeGrid> - The maze grid with CellType values.
+     */
+    std::shared_ptr<MazeGrid> getMaze() const { return maze; }
+
+    /**
+     * @brief Gets the algorithm instance, for its memory usage.
+     *
+     * @return const Algorithm& - The policy.
+     */
+    const Algorithm& getPolicy() const { return policy; }
+
+    /**
+     * @brief Saves the generated maze to a binary maze file.
+     *
+     * @param path Path of the file to write.
+     * @return bool - True if the file was written, false otherwise.
+     */
+    bool saveMaze(const std::string& path) const {
+        MazeFileInfo info;
+        info.size = size;
+        info.startX = 1;
+        info.startY = 1;
+        info.endX = size-1;
+        info.endY = size-2;
+        info.seed = seed;
+        info.algorithm = Algorithm::algorithm;
+        return saveMazeFile(path, *maze, info);
+    }
+
+protected:
+    int size; // The size (width and height) of the maze
+    uint64_t seed; // The seed the maze was generated with
+    Algorithm policy; // The generation algorithm
+    std::shared_ptr<MazeGrid> maze; // The maze represented with CellType values
+};
+
+/**
+ * @brief Gets the command-line name of an algorithm.
+ *
+ * @param algorithm The algorithm.
+ * @return const char* - dfs, parallel, eller, kruskal, prim, wilson or binarytree.
+ */
+const char* getAlgorithmName(MazeAlgorithm algorithm);
+
+/**
+ * @brief Parses the command-line name of an algorithm.
+ *
+ * @param name The name as returned by getAlgorithmName().
+ * @param algorithm Receives the algorithm.
+ * @return bool - True if the name is known, false otherwise.
+ */
+bool parseAlgorithmName(const std::string& name, MazeAlgorithm& algorithm);
+
+/**
+ * @brief Generates a maze with a policy algorithm chosen at runtime.
+ *
+ * The choice is made once per maze, the generation itself runs the specialized PolicyMazeGenerator.
+ *
+ * @param algorithm The algorithm, ALGORITHM_PARALLEL_DFS is not a policy and is rejected.
+ * @param size The size (width and height) of the maze, must be odd.
+ * @param seed The seed of the algorithm.
+ * @param savePath Maze file to write, empty to skip saving.
+ * @return std::shared_ptr<MazeGrid> - The maze, or nullptr if the algorithm is not a policy.
+ */
+std::shared_ptr<MazeGrid> generatePolicyMaze(MazeAlgorithm algorithm, int size, uint64_t seed, const std::string& savePath = "");
@@ -0,0 +1,195 @@
+#include "MazeCollision.h"
+
+namespace {
+
+/**
+ * @brief Intersects a segment with an axis-aligned box using the slab method.
+ *
+ * Segments starting inside the box are ignored, MazeCollision::depenetrate() resolves those.
+ *
+ * @return double - Fraction of the segment at the entry point, above 1 if the box is not entered.
+ */
+double sweepBox(double x, double y, double dx, double dy, double minX, double minY, double maxX, double maxY,
+                double& normalX, double& normalY) {
+    double enter = -HUGE_VAL, exit = HUGE_VAL;
+    double enterNormalX = 0.0, enterNormalY = 0.0;
+
+    if (dx != 0.0) {
+        double t0 = (minX - x) / dx, t1 = (maxX - x) / dx;
+        double n = -1.0;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+            n = 1.0;
+        }
+        if (t0 > enter) {
+            enter = t0;
+            enterNormalX = n;
+            enterNormalY = 0.0;
+        }
+        exit = std::min(exit, t1);
+    } else if (x <= minX || x >= maxX) {
+        return HUGE_VAL;
+    }
+
+    if (dy != 0.0) {
+        double t0 = (minY - y) / dy, t1 = (maxY - y) / dy;
+        double n = -1.0;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+            n = 1.0;
+        }
+        if (t0 > enter) {
+            enter = t0;
+            enterNormalX = 0.0;
+            enterNormalY = n;
+        }
+        exit = std::min(exit, t1);
+    } else if (y <= minY || y >= maxY) {
+        return HUGE_VAL;
+    }
+
+    if (enter < 0.0 || enter > exit) {
+        return HUGE_VAL;
+    }
+    normalX = enterNormalX;
+    normalY = enterNormalY;
+    return enter;
+}
+
+/**
+ * @brief Intersects a segment with a circle.
+ *
+ * @return double - Fraction of the segment at the entry point, above 1 if the circle is not entered.
+ */
+double sweepCircle(double x, double y, double dx, double dy, double centerX, double centerY, double radius,
+                   double& normalX, double& normalY) {
+    double ox = x - centerX, oy = y - centerY;
+    double a = dx * dx + dy * dy;
+    double b = 2.0 * (ox * dx + oy * dy);
+    double c = ox * ox + oy * oy - radius * radius;
+    if (c < 0.0 || b >= 0.0) {
+        return HUGE_VAL; // Starting inside or moving away
+    }
+    double discriminant = b * b - 4.0 * a * c;
+    if (discriminant < 0.0) {
+        return HUGE_VAL;
+    }
+    double t = (-b - std::sqrt(discriminant)) / (2.0 * a);
+    normalX = (ox + dx * t) / radius;
+    normalY = (oy + dy * t) / radius;
+    return t;
+}
+
+}
+
+MazeCollision::MazeCollision(std::shared_ptr<const MazeGrid> maze, double radius): maze(maze), radius(radius) { }
+
+osg::Vec3d MazeCollision::move(const osg::Vec3d& from, const osg::Vec3d& to) const {
+    double x = from.x(), y = from.y();
+    double dx = to.x() - x, dy = to.y() - y;
+    depenetrate(x, y);
+
+    for (int slide = 0; slide <= COLLISION_MAX_SLIDES; slide++) {
+        double length = std::sqrt(dx * dx + dy * dy);
+        if (length < COLLISION_EPSILON) {
+            break;
+        }
+
+        double normalX = 0.0, normalY = 0.0;
+        double t = sweep(x, y, dx, dy, normalX, normalY);
+        if (t > 1.0) {
+            x += dx;
+            y += dy;
+            break;
+        }
+
+        // Stop just short of the contact, then slide the rest of the move along the wall
+        double safe = std::max(0.0, t - COLLISION_EPSILON / length);
+        x += dx * safe;
+        y += dy * safe;
+        dx *= 1.0 - safe;
+        dy *= 1.0 - safe;
+        double into = dx * normalX + dy * normalY;
+        if (into < 0.0) {
+            dx -= into * normalX;
+            dy -= into * normalY;
+        }
+    }
+
+    return osg::Vec3d(x, y, to.z());
+}
+
+bool MazeCollision::overlaps(double x, double y) const {
+    int cellX = static_cast<int>(std::floor(x + 0.5)), cellY = static_cast<int>(std::floor(y + 0.5));
+    for (int i = cellX - 1; i <= cellX + 1; i++) {
+        for (int j = cellY - 1; j <= cellY + 1; j++) {
+            if (!isSolid(i, j)) {
+                continue;
+            }
+            double closestX = std::max(i - 0.5, std::min(x, i + 0.5));
+            double closestY = std::max(j - 0.5, std::min(y, j + 0.5));
+            if ((x - closestX) * (x - closestX) + (y - closestY) * (y - closestY) < radius * radius) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void MazeCollision::depenetrate(double& x, double& y) const {
+    int cellX = static_cast<int>(std::floor(x + 0.5)), cellY = static_cast<int>(std::floor(y + 0.5));
+    for (int i = cellX - 1; i <= cellX + 1; i++) {
+        for (int j = cellY - 1; j <= cellY + 1; j++) {
+            if (!isSolid(i, j)) {
+                continue;
+            }
+            double closestX = std::max(i - 0.5, std::min(x, i + 0.5));
+            double closestY = std::max(j - 0.5, std::min(y, j + 0.5));
+            double ox = x - closestX, oy = y - closestY;
+            double distance = std::sqrt(ox * ox + oy * oy);
+            if (distance >= radius) {
+                continue;
+            }
+            if (distance > 0.0) {
+                x = closestX + ox / distance * (radius + COLLISION_EPSILON);
+                y = closestY + oy / distance * (radius + COLLISION_EPSILON);
+            } else if (std::fabs(x - i) > std::fabs(y - j)) {
+                // Center inside the wall, leave through the nearest side
+                x = x > i ? i + 0.5 + radius + COLLISION_EPSILON : i - 0.5 - radius - COLLISION_EPSILON;
+            } else {
+                y = y > j ? j + 0.5 + radius + COLLISION_EPSILON : j - 0.5 - radius - COLLISION_EPSILON;
+            }
+        }
+    }
+}
+
+double MazeCollision::sweep(double x, double y, double dx, double dy, double& normalX, double& normalY) const {
+    // Cells whose rounded squares the swept circle can touch, one ring outside the maze is enough
+    int size = maze->getSize();
+    int minX = std::max(-1, static_cast<int>(std::floor(std::min(x, x + dx) - radius + 0.5)));
+    int maxX = std::min(size, static_cast<int>(std::floor(std::max(x, x + dx) + radius + 0.5)));
+    int minY = std::max(-1, static_cast<int>(std::floor(std::min(y, y + dy) - radius + 0.5)));
+    int maxY = std::min(size, static_cast<int>(std::floor(std::max(y, y + dy) + radius + 0.5)));
+
+    double best = HUGE_VAL;
+    for (int i = minX; i <= maxX; i++) {
+        for (int j = minY; j <= maxY; j++) {
+            if (!isSolid(i, j)) {
+                continue;
+            }
+
+            // The square grown by the radius is two boxes and four corner circles
+            double nx = 0.0, ny = 0.0, t;
+            t = sweepBox(x, y, dx, dy, i - 0.5 - radius, j - 0.5, i + 0.5 + radius, j + 0.5, nx, ny);
+            if (t < best) { best = t; normalX = nx; normalY = ny; }
+            t = sweepBox(x, y, dx, dy, i - 0.5, j - 0.5 - radius, i + 0.5, j + 0.5 + radius, nx, ny);
+            if (t < best) { best = t; normalX = nx; normalY = ny; }
+            for (int corner = 0; corner < 4; corner++) {
+                double cornerX = i + ((corner & 1) ? 0.5 : -0.5), cornerY = j + ((corner & 2) ? 0.5 : -0.5);
+                t = sweepCircle(x, y, dx, dy, cornerX, cornerY, radius, nx, ny);
+                if (t < best) { best = t; normalX = nx; normalY = ny; }
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <osg/Vec3d>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "MazeGrid.h"
+
+#define COLLISION_MAX_SLIDES 4 // Number of times a move may slide along a wall after hitting it
+#define COLLISION_EPSILON 1e-4 // Gap kept between the circle and the wall it stopped at
+
+/**
+ * @class MazeCollision
+ * @brief Moves a circle through the maze without entering walls.
+ *
+ * Every WALL cell (x, y) is the square [x-0.5, x+0.5] x [y-0.5, y+0.5], and cells outside the maze count
+ * as walls. The squares are read straight from the packed MazeGrid instead of a separate table, so the
+ * collision structure costs no memory. A move is swept against the squares rounded by the circle
+ * radius, which finds the exact time of the first contact however long the move is, and the rest of
+ * the move slides along the wall that was hit. Queries do not allocate.
+ */
+class MazeCollision {
+public:
+    /**
+     * @brief Constructor for MazeCollision.
+     *
+     * @param maze The shared maze grid.
+     * @param radius Radius of the moving circle, less than 0.5.
+     */
+    MazeCollision(std::shared_ptr<const MazeGrid> maze, double radius);
+
+    /**
+     * @brief Moves the circle from one point towards another, stopping at walls and sliding along them.
+     *
+     * @param from Start of the move, only x and y are used.
+     * @param to Requested end of the move, its z-coordinate is kept.
+     * @return osg::Vec3d - The reachable end of the move.
+     */
+    osg::Vec3d move(const osg::Vec3d& from, const osg::Vec3d& to) const;
+
+    /**
+     * @brief Checks if the circle overlaps a wall.
+     *
+     * @param x The x-coordinate of the circle center.
+     * @param y The y-coordinate of the circle center.
+     * @return bool - True if any wall is closer than the radius, false otherwise.
+     */
+    bool overlaps(double x, double y) const;
+
+protected:
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+    double radius; // Radius of the moving circle
+
+    /**
+     * @brief Checks if the specified cell blocks movement.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return bool - True if the cell is a wall or lies outside the maze, false otherwise.
+     */
+    bool isSolid(int x, int y) const { return !maze->contains(x, y) || maze->get(x, y) == WALL; }
+
+    /**
+     * @brief Pushes the circle center out of walls it overlaps.
+     *
+     * @param x The x-coordinate of the circle center, updated in place.
+     * @param y The y-coordinate of the circle center, updated in place.
+     */
+    void depenetrate(double& x, double& y) const;
+
+    /**
+     * @brief Finds the first contact of the circle moving along a segment with the walls.
+     *
+     * @param x The x-coordinate of the start of the segment.
+     * @param y The y-coordinate of the start of the segment.
+     * @param dx The x-component of the segment.
+     * @param dy The y-component of the segment.
+     * @param normalX Receives the x-component of the wall normal at the contact.
+     * @param normalY Receives the y-component of the wall normal at the contact.
+     * @return double - Fraction of the segment before the contact, above 1 if there is none.
+     */
+    double sweep(double x, double y, double dx, double dy, double& normalX, double& normalY) const;
+};
@@ -0,0 +1,231 @@
+#include "MazeDistanceField.h"
+
+namespace {
+
+const int dirX[] = {0, 0, 1, -1};
+const int dirY[] = {1, -1, 0, 0};
+
+}
+
+const uint32_t DistanceField::UNREACHABLE;
+
+DistanceField::DistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY):
+    maze(maze),
+    endX(endX),
+    endY(endY),
+    roomsPerSide(maze->getSize() / 2),
+    computeTime(0.0)
+{
+}
+
+MazeDistanceField::MazeDistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY):
+    DistanceField(maze, endX, endY),
+    distances(static_cast<size_t>(roomsPerSide) * roomsPerSide, UNREACHABLE)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // The exit is either a room itself or sits in a passage of the outer wall next to one
+    std::queue<uint32_t> queue;
+    if (isRoom(endX, endY)) {
+        distances[getRoomIndex(endX, endY)] = 0;
+        queue.push(static_cast<uint32_t>(getRoomIndex(endX, endY)));
+    } else if (maze->contains(endX, endY) && maze->get(endX, endY) != WALL) {
+        for (int d = 0; d < 4; d++) {
+            if (isRoom(endX + dirX[d], endY + dirY[d])) {
+                distances[getRoomIndex(endX + dirX[d], endY + dirY[d])] = 1;
+                queue.push(static_cast<uint32_t>(getRoomIndex(endX + dirX[d], endY + dirY[d])));
+            }
+        }
+    }
+
+    // Neighbouring rooms are two steps apart through the passage between them
+    while (!queue.empty()) {
+        uint32_t room = queue.front();
+        queue.pop();
+        int x = 2 * static_cast<int>(room / roomsPerSide) + 1, y = 2 * static_cast<int>(room % roomsPerSide) + 1;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + 2 * dirX[d], ny = y + 2 * dirY[d];
+            if (maze->get(x + dirX[d], y + dirY[d]) != WALL && isRoom(nx, ny)
+                    && distances[getRoomIndex(nx, ny)] == UNREACHABLE) {
+                distances[getRoomIndex(nx, ny)] = distances[room] + 2;
+                queue.push(static_cast<uint32_t>(getRoomIndex(nx, ny)));
+            }
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    computeTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+uint32_t MazeDistanceField::getDistance(int x, int y) const {
+    if (!maze->contains(x, y) || maze->get(x, y) == WALL) {
+        return UNREACHABLE;
+    }
+    if (x == endX && y == endY) {
+        return 0;
+    }
+    if (isRoom(x, y)) {
+        return distances[getRoomIndex(x, y)];
+    }
+
+    // A passage is one step farther than the nearer of its rooms
+    uint32_t best = UNREACHABLE;
+    for (int d = 0; d < 4; d++) {
+        int nx = x + dirX[d], ny = y + dirY[d];
+        if (nx == endX && ny == endY) {
+            return 1;
+        }
+        if (isRoom(nx, ny)) {
+            best = std::min(best, distances[getRoomIndex(nx, ny)]);
+        }
+    }
+    return best == UNREACHABLE ? UNREACHABLE : best + 1;
+}
+
+std::pair<int, int> MazeDistanceField::getHintStep(int x, int y) const {
+    uint32_t distance = getDistance(x, y);
+    if (distance == 0 || distance == UNREACHABLE) {
+        return std::make_pair(0, 0);
+    }
+    for (int d = 0; d < 4; d++) {
+        if (getDistance(x + dirX[d], y + dirY[d]) < distance) {
+            return std::make_pair(dirX[d], dirY[d]);
+        }
+    }
+    return std::make_pair(0, 0);
+}
+
+void MazeDistanceField::printStats() const {
+    std::cout << "DISTANCE FIELD: " << distances.size() << " rooms, "
+              << distances.size() * sizeof(uint32_t) / (1024.0 * 1024.0) << " MB, computed in "
+              << computeTime << " ms" << std::endl;
+}
+
+CompactDistanceField::CompactDistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY):
+    DistanceField(maze, endX, endY),
+    levels((static_cast<size_t>(roomsPerSide) * roomsPerSide + 3) / 4, 0xFF)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // The exit is either a room itself or sits in a passage of the outer wall next to one
+    std::vector<uint32_t> frontier, next;
+    uint32_t offset = 0; // Distance of the rooms on level 0
+    if (isRoom(endX, endY)) {
+        frontier.push_back(static_cast<uint32_t>(getRoomIndex(endX, endY)));
+    } else if (maze->contains(endX, endY) && maze->get(endX, endY) != WALL) {
+        offset = 1;
+        for (int d = 0; d < 4; d++) {
+            if (isRoom(endX + dirX[d], endY + dirY[d])) {
+                frontier.push_back(static_cast<uint32_t>(getRoomIndex(endX + dirX[d], endY + dirY[d])));
+            }
+        }
+    }
+    for (uint32_t room : frontier) {
+        setLevel(room, 0);
+    }
+
+    // Neighbouring rooms are two steps apart through the passage between them
+    for (uint32_t level = 0; !frontier.empty(); level++) {
+        if (level % DISTANCE_CHECKPOINT_LEVELS == 0) {
+            for (uint32_t room : frontier) {
+                checkpoints.push_back(std::make_pair(room, 2 * level + offset));
+            }
+        }
+
+        next.clear();
+        for (uint32_t room : frontier) {
+            int x = 2 * static_cast<int>(room / roomsPerSide) + 1, y = 2 * static_cast<int>(room % roomsPerSide) + 1;
+            for (int d = 0; d < 4; d++) {
+                int nx = x + 2 * dirX[d], ny = y + 2 * dirY[d];
+                if (maze->get(x + dirX[d], y + dirY[d]) != WALL && isRoom(nx, ny)
+                        && getLevel(getRoomIndex(nx, ny)) == DISTANCE_LEVEL_UNREACHED) {
+                    setLevel(getRoomIndex(nx, ny), static_cast<int>((level + 1) % 3));
+                    next.push_back(static_cast<uint32_t>(getRoomIndex(nx, ny)));
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    std::sort(checkpoints.begin(), checkpoints.end());
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    computeTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+uint32_t CompactDistanceField::getDistance(int x, int y) const {
+    // Walk towards the exit until a checkpoint room, at most DISTANCE_CHECKPOINT_LEVELS rooms away
+    uint32_t steps = 0;
+    while (x != endX || y != endY) {
+        if (isRoom(x, y)) {
+            auto checkpoint = std::lower_bound(checkpoints.begin(), checkpoints.end(),
+                                               std::make_pair(static_cast<uint32_t>(getRoomIndex(x, y)), 0u));
+            if (checkpoint != checkpoints.end() && checkpoint->first == getRoomIndex(x, y)) {
+                return checkpoint->second + steps;
+            }
+        }
+
+        int d = getCloserDirection(x, y);
+        if (d < 0) {
+            return UNREACHABLE;
+        }
+        x += dirX[d];
+        y += dirY[d];
+        steps++;
+    }
+    return steps;
+}
+
+std::pair<int, int> CompactDistanceField::getHintStep(int x, int y) const {
+    int d = getCloserDirection(x, y);
+    if (d < 0) {
+        return std::make_pair(0, 0);
+    }
+    return std::make_pair(dirX[d], dirY[d]);
+}
+
+int CompactDistanceField::getCloserDirection(int x, int y) const {
+    if (!maze->contains(x, y) || maze->get(x, y) == WALL || (x == endX && y == endY)) {
+        return -1;
+    }
+    for (int d = 0; d < 4; d++) {
+        if (x + dirX[d] == endX && y + dirY[d] == endY) {
+            return d;
+        }
+    }
+
+    if (isRoom(x, y)) {
+        int level = getLevel(getRoomIndex(x, y));
+        if (level == DISTANCE_LEVEL_UNREACHED) {
+            return -1;
+        }
+        for (int d = 0; d < 4; d++) {
+            int nx = x + 2 * dirX[d], ny = y + 2 * dirY[d];
+            if (maze->get(x + dirX[d], y + dirY[d]) != WALL && isRoom(nx, ny) && getLevel(getRoomIndex(nx, ny)) == (level + 2) % 3) {
+                return d;
+            }
+        }
+        return -1;
+    }
+
+    // A passage is one step farther than the nearer of its rooms, whose level is one lower or equal
+    int best = -1, bestLevel = DISTANCE_LEVEL_UNREACHED;
+    for (int d = 0; d < 4; d++) {
+        int nx = x + dirX[d], ny = y + dirY[d];
+        if (!isRoom(nx, ny) || getLevel(getRoomIndex(nx, ny)) == DISTANCE_LEVEL_UNREACHED) {
+            continue;
+        }
+        int level = getLevel(getRoomIndex(nx, ny));
+        if (best < 0 || level == (bestLevel + 2) % 3) {
+            best = d;
+            bestLevel = level;
+        }
+    }
+    return best;
+}
+
+void CompactDistanceField::printStats() const {
+    size_t bytes = levels.size() + checkpoints.size() * sizeof(checkpoints[0]);
+    std::cout << "COMPACT DISTANCE FIELD: " << static_cast<size_t>(roomsPerSide) * roomsPerSide << " rooms, "
+              << checkpoints.size() << " checkpoints, " << bytes / (1024.0 * 1024.0) << " MB, computed in "
+              << computeTime << " ms" << std::endl;
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "MazeGrid.h"
+
+#define DISTANCE_CHECKPOINT_LEVELS 64 // Levels between two rooms whose exact distance is stored by CompactDistanceField
+#define DISTANCE_LEVEL_UNREACHED 3 // Stored level of rooms cut off from the exit
+
+/**
+ * @class DistanceField
+ * @brief Interface of the precomputed number of steps from every open cell to the exit.
+ *
+ * The generators place rooms on odd coordinates and connect them through single passage cells,
+ * so the implementations only store the rooms.
+ */
+class DistanceField {
+public:
+    static const uint32_t UNREACHABLE = 0xFFFFFFFF; // Distance of walls and cells cut off from the exit
+
+    virtual ~DistanceField() { }
+
+    /**
+     * @brief Gets the number of steps from a cell to the exit.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return uint32_t - Number of steps, UNREACHABLE for walls, cells outside the maze or cut off from the exit.
+     */
+    virtual uint32_t getDistance(int x, int y) const = 0;
+
+    /**
+     * @brief Gets the neighbour to step to in order to get closer to the exit.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return std::pair<int, int> - Offset of the neighbour, (0, 0) at the exit or if the exit cannot be reached.
+     */
+    virtual std::pair<int, int> getHintStep(int x, int y) const = 0;
+
+    /**
+     * @brief Prints the memory used by the field and the time it took to compute.
+     */
+    virtual void printStats() const = 0;
+
+protected:
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+    int endX; // The x-coordinate of the exit
+    int endY; // The y-coordinate of the exit
+    int roomsPerSide; // Number of rooms along each side of the maze
+    double computeTime; // Time spent computing the field in milliseconds
+
+    /**
+     * @brief Constructor for DistanceField.
+     *
+     * @param maze The shared maze grid.
+     * @param endX The x-coordinate of the exit.
+     * @param endY The y-coordinate of the exit.
+     */
+    DistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY);
+
+    /**
+     * @brief Checks if the specified cell is an open room.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return bool - True if both coordinates are odd and the cell is inside the maze and not a wall.
+     */
+    bool isRoom(int x, int y) const { return (x & 1) && (y & 1) && maze->contains(x, y) && maze->get(x, y) != WALL; }
+
+    /**
+     * @brief Gets the index of a room in the room array.
+     *
+     * @param x The x-coordinate of the room.
+     * @param y The y-coordinate of the room.
+     * @return size_t - Index of the room.
+     */
+    size_t getRoomIndex(int x, int y) const { return static_cast<size_t>(x / 2) * roomsPerSide + y / 2; }
+};
+
+/**
+ * @class MazeDistanceField
+ * @brief Dense distance field, the default one.
+ *
+ * Stores 4 bytes per room or 1 byte per cell of the grid. The distance of a passage follows from
+ * the rooms next to it, which keeps every query O(1), about 30 ns.
+ */
+class MazeDistanceField : public DistanceField {
+public:
+    /**
+     * @brief Constructor for MazeDistanceField, runs a breadth-first search from the exit over the rooms.
+     *
+     * @param maze The shared maze grid.
+     * @param endX The x-coordinate of the exit.
+     * @param endY The y-coordinate of the exit.
+     */
+    MazeDistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY);
+
+    virtual uint32_t getDistance(int x, int y) const;
+    virtual std::pair<int, int> getHintStep(int x, int y) const;
+    virtual void printStats() const;
+
+protected:
+    std::vector<uint32_t> distances; // Steps to the exit of every room
+};
+
+/**
+ * @class CompactDistanceField
+ * @brief Distance field of paged mazes, whose dense field would not fit in memory.
+ *
+ * A room's level is its number of room steps from the exit; connected rooms differ by at most one level,
+ * so the level modulo 3 in 2 bits per room is enough to tell which neighbour is closer, and hint steps
+ * stay O(1). The exact distance of every room on a level divisible by DISTANCE_CHECKPOINT_LEVELS is stored
+ * as well. Together that is about 0.1 bytes per cell of the grid, a tenth of MazeDistanceField, but a
+ * distance query walks up to DISTANCE_CHECKPOINT_LEVELS rooms towards the exit with a binary search over
+ * the checkpoints at each room, about 3 µs or 100x slower than the dense field.
+ */
+class CompactDistanceField : public DistanceField {
+public:
+    /**
+     * @brief Constructor for CompactDistanceField, runs a breadth-first search from the exit over the rooms.
+     *
+     * @param maze The shared maze grid.
+     * @param endX The x-coordinate of the exit.
+     * @param endY The y-coordinate of the exit.
+     */
+    CompactDistanceField(std::shared_ptr<const MazeGrid> maze, int endX, int endY);
+
+    virtual uint32_t getDistance(int x, int y) const;
+    virtual std::pair<int, int> getHintStep(int x, int y) const;
+    virtual void printStats() const;
+
+protected:
+    std::vector<uint8_t> levels; // Level modulo 3 of every room, 2 bits per room
+    std::vector<std::pair<uint32_t, uint32_t>> checkpoints; // Room index and distance of the checkpoint rooms, sorted by index
+
+    /**
+     * @brief Finds the neighbour one step closer to the exit.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return int - Index of the direction towards the neighbour, -1 at the exit, for walls or if the exit cannot be reached.
+     */
+    int getCloserDirection(int x, int y) const;
+
+    /**
+     * @brief Gets the stored level of a room.
+     *
+     * @param room Index of the room.
+     * @return int - The level modulo 3, DISTANCE_LEVEL_UNREACHED if the room is cut off from the exit.
+     */
+    int getLevel(size_t room) const { return (levels[room / 4] >> (2 * (room % 4))) & 3; }
+
+    /**
+     * @brief Stores the level of a room.
+     *
+     * @param room Index of the room.
+     * @param level The level modulo 3.
+     */
+    void setLevel(size_t room, int level) { levels[room / 4] = static_cast<uint8_t>((levels[room / 4] & ~(3 << (2 * (room % 4)))) | (level << (2 * (room % 4)))); }
+};
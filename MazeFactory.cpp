@@ -0,0 +1,366 @@
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MazeAlgorithms.h"
+#include "ParallelMazeGenerator.h"
+#include "MazeSolver.h"
+#include "MazeFile.h"
+
+// g++ -O2 -pthread -o maze_factory MazeFactory.cpp MazeAlgorithms.cpp ParallelMazeGenerator.cpp EllerGenerator.cpp MazeGrid.cpp MazeFile.cpp Random.cpp MazeSolver.cpp -lz
+// Usage: ./maze_factory --count N [--size S,...] [--algorithm dfs|parallel|eller|kruskal|prim|wilson|binarytree,...] [--seed N] [--threads N] [--solve] [--output FILE] [--index FILE]
+//        ./maze_factory --stream FILE [--size S] [--seed N]
+// Runs headless, no window or graphics context is created.
+// Maze i gets the seed N+i and cycles through the listed sizes and algorithms.
+// The output file holds the maze files of the batch back to back, gzip-compressed when the name ends with .gz.
+// Prints one CSV line: mazes,threads,seconds,mazes_per_s,cells_per_s,raw_bytes,output_bytes,mean_distance
+// With --stream one Eller maze is written to FILE row by row without holding the grid, and the line is
+// size,seed,seconds,rows_per_s,cells_per_s,row_state_bytes
+
+#define FACTORY_BUFFER_SIZE (1 << 20) // Bytes buffered by the output file before each write
+#define FACTORY_WINDOW 4 // Finished mazes allowed to wait for the writer per worker thread
+
+/**
+ * @struct FactoryJob
+ * @brief Parameters of one maze of the batch.
+ */
+struct FactoryJob {
+    int size; // The size (width and height) of the maze
+    uint64_t seed; // The seed of the maze
+    MazeAlgorithm algorithm; // The generator to use
+};
+
+/**
+ * @struct FactoryResult
+ * @brief A finished maze waiting for the writer.
+ */
+struct FactoryResult {
+    bool ready = false; // Set by the worker once the record is complete
+    bool failed = false; // Set if the record could not be built, nothing is written for it
+    std::string record; // Bytes to append to the output, a maze file or a gzip member holding one
+    size_t rawBytes = 0; // Size of the uncompressed maze file
+    int distance = -1; // Steps from START to END, -1 if not solved
+};
+
+/**
+ * @brief Splits a comma-separated list.
+ *
+ * @param list The list.
+ * @return std::vector<std::string> - The items, empty ones skipped.
+ */
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Generates the maze of a job on the calling thread.
+ *
+ * @param job The job.
+ * @return std::shared_ptr<const MazeGrid> - The maze, START at (1, 1) and END at (size-1, size-2).
+ */
+std::shared_ptr<const MazeGrid> generate(const FactoryJob& job) {
+    switch (job.algorithm) {
+        case ALGORITHM_PARALLEL_DFS: {
+            // The batch is already spread over the cores, so every maze gets a single thread
+            ParallelMazeGenerator generator(job.size, job.seed, 1);
+            return generator.getMaze();
+        }
+        default:
+            return generatePolicyMaze(job.algorithm, job.size, job.seed);
+    }
+}
+
+/**
+ * @brief Compresses a record into a self-contained gzip member.
+ *
+ * Concatenated members form a valid gzip stream, so workers compress in parallel and the writer only appends.
+ *
+ * @param record The uncompressed bytes, replaced by the compressed ones.
+ * @return bool - True on success, false otherwise.
+ */
+bool compressRecord(std::string& record) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    std::string compressed(deflateBound(&stream, static_cast<uLong>(record.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(&record[0]);
+    stream.avail_in = static_cast<uInt>(record.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    int status = deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        return false;
+    }
+
+    record.swap(compressed);
+    return true;
+}
+
+/**
+ * @brief Generates, optionally solves and serializes one maze.
+ *
+ * @param job The job.
+ * @param solve Whether to measure the distance from START to END.
+ * @param compress Whether to gzip the record.
+ * @param result Receives the record.
+ */
+void buildRecord(const FactoryJob& job, bool solve, bool compress, FactoryResult& result) {
+    std::shared_ptr<const MazeGrid> maze = generate(job);
+    int size = maze->getSize();
+    if (solve) {
+        MazeSolver solver(maze);
+        result.distance = solver.getDistanceBitParallel(1, 1, size-1, size-2);
+    }
+
+    MazeFileInfo info;
+    info.size = size;
+    info.startX = 1;
+    info.startY = 1;
+    info.endX = size-1;
+    info.endY = size-2;
+    info.seed = job.seed;
+    info.algorithm = job.algorithm;
+
+    MazeFileHeader header;
+    fillMazeFileHeader(header, *maze, info);
+    result.record.reserve(sizeof(header) + maze->getMemoryUsage());
+    result.record.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    result.record.append(reinterpret_cast<const char*>(maze->getRow(0)), maze->getMemoryUsage());
+    result.rawBytes = result.record.size();
+
+    if (compress && !compressRecord(result.record)) {
+        std::cerr << "Cannot compress maze with seed " << job.seed << std::endl;
+        result.record.clear();
+        result.failed = true;
+    }
+}
+
+/**
+ * @brief Streams one maze to a maze file with EllerGenerator, memory proportional to its width.
+ *
+ * @param path Path of the file to write.
+ * @param size The size (width and height) of the maze.
+ * @param seed The seed of the maze.
+ * @return int - Exit code of the program.
+ */
+int streamMaze(const std::string& path, int size, uint64_t seed) {
+    MazeFileInfo info;
+    info.startX = 1;
+    info.startY = 1;
+    info.endX = size - 1;
+    info.endY = size - 2;
+    info.seed = seed;
+    info.algorithm = ALGORITHM_ELLER;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    EllerGenerator generator(size, seed);
+    MazeFileSink sink(path, info);
+    generator.generate(sink);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    if (!sink.isWritten()) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+    std::cout << "size,seed,seconds,rows_per_s,cells_per_s,row_state_bytes\n"
+              << size << "," << seed << "," << seconds << "," << size / seconds << ","
+              << static_cast<double>(size) * size / seconds << ","
+              << generator.getMemoryUsage() + sink.getMemoryUsage() << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int count = 1;
+    std::vector<int> sizes = {25};
+    std::vector<MazeAlgorithm> algorithms = {ALGORITHM_DFS};
+    uint64_t seed = 1;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool solve = false;
+    std::string outputPath, indexPath, streamPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--count" && i + 1 < argc) {
+            count = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--size" && i + 1 < argc) {
+            sizes.clear();
+            for (const std::string& item : splitList(argv[++i])) {
+                // Clamped like the game's --size, so every written file loads again
+                sizes.push_back(std::min(std::max(MIN_MAZE, std::atoi(item.c_str())) | 1, MAX_MAZE));
+            }
+        } else if (arg == "--algorithm" && i + 1 < argc) {
+            algorithms.clear();
+            for (const std::string& item : splitList(argv[++i])) {
+                MazeAlgorithm algorithm;
+                if (!parseAlgorithmName(item, algorithm)) {
+                    return 1;
+                }
+                algorithms.push_back(algorithm);
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--solve") {
+            solve = true;
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--index" && i + 1 < argc) {
+            indexPath = argv[++i];
+        } else if (arg == "--stream" && i + 1 < argc) {
+            streamPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (sizes.empty() || algorithms.empty()) {
+        std::cerr << "No maze size or algorithm given" << std::endl;
+        return 1;
+    }
+    if (!streamPath.empty()) {
+        return streamMaze(streamPath, sizes[0], seed);
+    }
+
+    // The buffer must be installed before the file is opened to take effect
+    std::vector<char> buffer(FACTORY_BUFFER_SIZE);
+    std::ofstream output;
+    output.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    bool compress = outputPath.size() > 3 && outputPath.compare(outputPath.size() - 3, 3, ".gz") == 0;
+    if (!outputPath.empty()) {
+        output.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            std::cerr << "Cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream index;
+    if (!indexPath.empty()) {
+        index.open(indexPath, std::ios::trunc);
+        if (!index) {
+            std::cerr << "Cannot write " << indexPath << std::endl;
+            return 1;
+        }
+        index << "maze,size,seed,algorithm,offset,bytes,distance\n";
+    }
+
+    std::vector<FactoryJob> jobs(count);
+    for (int i = 0; i < count; i++) {
+        jobs[i].size = sizes[i % sizes.size()];
+        jobs[i].seed = seed + static_cast<uint64_t>(i);
+        jobs[i].algorithm = algorithms[i % algorithms.size()];
+    }
+
+    // Workers run ahead of the writer by at most a few mazes each, so memory stays bounded
+    std::vector<FactoryResult> results(count);
+    std::mutex mutex;
+    std::condition_variable readyCondition, writtenCondition;
+    std::atomic<int> nextJob(0);
+    int written = 0;
+    int window = static_cast<int>(threads) * FACTORY_WINDOW;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto worker = [&]() {
+        for (int i = nextJob++; i < count; i = nextJob++) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                writtenCondition.wait(lock, [&]() { return i < written + window; });
+            }
+            FactoryResult result;
+            buildRecord(jobs[i], solve, compress, result);
+            result.ready = true;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                results[i] = std::move(result);
+            }
+            readyCondition.notify_all();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back(worker);
+    }
+
+    // Records are written in job order so the output does not depend on the thread count
+    size_t rawBytes = 0, outputBytes = 0;
+    double cells = 0.0, distances = 0.0;
+    int failures = 0, solved = 0;
+    for (int i = 0; i < count; i++) {
+        FactoryResult result;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readyCondition.wait(lock, [&]() { return results[i].ready; });
+            result = std::move(results[i]);
+            results[i] = FactoryResult();
+            written = i + 1;
+        }
+        writtenCondition.notify_all();
+
+        // A failed maze is left out of the output and the index, the exit code reports it
+        if (result.failed) {
+            failures++;
+            continue;
+        }
+        if (output.is_open()) {
+            output.write(result.record.data(), static_cast<std::streamsize>(result.record.size()));
+        }
+        if (index.is_open()) {
+            index << i << "," << jobs[i].size << "," << jobs[i].seed << "," << getAlgorithmName(jobs[i].algorithm) << ","
+                  << outputBytes << "," << result.record.size() << "," << result.distance << "\n";
+        }
+        rawBytes += result.rawBytes;
+        outputBytes += result.record.size();
+        cells += static_cast<double>(jobs[i].size) * jobs[i].size;
+        if (result.distance >= 0) {
+            distances += result.distance;
+            solved++;
+        }
+    }
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    if (output.is_open()) {
+        output.close();
+        if (output.fail()) {
+            std::cerr << "Cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+    std::cout << "mazes,threads,seconds,mazes_per_s,cells_per_s,raw_bytes,output_bytes,mean_distance\n"
+              << count << "," << threads << "," << seconds << "," << count / seconds << "," << cells / seconds << ","
+              << rawBytes << "," << outputBytes << "," << (solved > 0 ? distances / solved : -1.0) << std::endl;
+    if (failures > 0) {
+        std::cerr << failures << " of " << count << " mazes could not be written" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "MazeFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool isValidMazeInfo(const MazeFileInfo& info) {
+    if (info.size < MIN_MAZE || info.size > MAX_MAZE || info.size % 2 == 0 || info.algorithm > ALGORITHM_BINARY_TREE) {
+        return false;
+    }
+    auto contains = [&info](int x, int y) { return x >= 0 && x < info.size && y >= 0 && y < info.size; };
+    return contains(info.startX, info.startY) && contains(info.endX, info.endY);
+}
+
+void fillMazeFileHeader(MazeFileHeader& header, const MazeGrid& maze, const MazeFileInfo& info) {
+    MazeFileInfo gridInfo = info;
+    gridInfo.size = maze.getSize();
+    fillMazeFileHeader(header, gridInfo);
+}
+
+void fillMazeFileHeader(MazeFileHeader& header, const MazeFileInfo& info) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+    header.version = MAZE_FILE_VERSION;
+    header.size = static_cast<uint32_t>(info.size);
+    header.startX = static_cast<uint32_t>(info.startX);
+    header.startY = static_cast<uint32_t>(info.startY);
+    header.endX = static_cast<uint32_t>(info.endX);
+    header.endY = static_cast<uint32_t>(info.endY);
+    header.seed = info.seed;
+    header.algorithm = info.algorithm;
+    header.rowWords = static_cast<uint32_t>(MazeGrid::getRowWords(info.size));
+}
+
+bool saveMazeFile(const std::string& path, const MazeGrid& maze, const MazeFileInfo& info) {
+    MazeFileHeader header;
+    fillMazeFileHeader(header, maze, info);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    // Rows are contiguous in memory, so the body is a single write
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(maze.getRow(0)), static_cast<std::streamsize>(maze.getMemoryUsage()));
+    return static_cast<bool>(file);
+}
+
+std::shared_ptr<MazeGrid> loadMazeFile(const std::string& path, MazeFileInfo& info) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open maze file " << path << std::endl;
+        return nullptr;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(MazeFileHeader)) {
+        std::cerr << "Invalid maze file " << path << std::endl;
+        close(fd);
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(status.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Cannot map maze file " << path << std::endl;
+        return nullptr;
+    }
+    std::shared_ptr<void> owner(mapping, [length](void* address) { munmap(address, length); });
+
+    const MazeFileHeader* header = static_cast<const MazeFileHeader*>(mapping);
+    if (std::memcmp(header->magic, MAZE_FILE_MAGIC, sizeof(header->magic)) != 0 || header->version != MAZE_FILE_VERSION
+            || header->size == 0 || header->size > MAX_MAZE
+            || header->rowWords != MazeGrid::getRowWords(static_cast<int>(header->size))
+            || length < sizeof(MazeFileHeader) + static_cast<size_t>(header->size) * header->rowWords * sizeof(uint64_t)) {
+        std::cerr << "Invalid maze file " << path << std::endl;
+        return nullptr;
+    }
+
+    info.size = static_cast<int>(header->size);
+    info.startX = static_cast<int>(header->startX);
+    info.startY = static_cast<int>(header->startY);
+    info.endX = static_cast<int>(header->endX);
+    info.endY = static_cast<int>(header->endY);
+    info.seed = header->seed;
+    info.algorithm = header->algorithm;
+    if (!isValidMazeInfo(info)) {
+        std::cerr << "Invalid maze file " << path << ": bad size, start, end or algorithm" << std::endl;
+        return nullptr;
+    }
+
+    uint64_t* words = reinterpret_cast<uint64_t*>(static_cast<char*>(mapping) + sizeof(MazeFileHeader));
+    return std::make_shared<MazeGrid>(info.size, words, owner);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "MazeGrid.h"
+
+#define MAZE_FILE_MAGIC "MAZEGRID" // First 8 bytes of every maze file
+#define MAZE_FILE_VERSION 1 // Current version of the maze file layout
+#define MIN_MAZE 5 // Minimum maze size
+#define MAX_MAZE 100001 // Maximum maze size, bounded only by memory since the generator no longer recurses
+
+/**
+ * @enum MazeAlgorithm
+ * @brief Generation algorithm recorded in a maze file.
+ */
+enum MazeAlgorithm {
+    ALGORITHM_DFS, // MazeGenerator
+    ALGORITHM_PARALLEL_DFS, // ParallelMazeGenerator
+    ALGORITHM_ELLER, // EllerGenerator
+    ALGORITHM_KRUSKAL, // PolicyMazeGenerator<KruskalPolicy>
+    ALGORITHM_PRIM, // PolicyMazeGenerator<PrimPolicy>
+    ALGORITHM_WILSON, // PolicyMazeGenerator<WilsonPolicy>
+    ALGORITHM_BINARY_TREE // PolicyMazeGenerator<BinaryTreePolicy>
+};
+
+/**
+ * @struct MazeFileInfo
+ * @brief Description of a maze stored in a maze file.
+ */
+struct MazeFileInfo {
+    int size = 0; // The size (width and height) of the maze
+    int startX = 0; // The x-coordinate of START
+    int startY = 0; // The y-coordinate of START
+    int endX = 0; // The x-coordinate of END
+    int endY = 0; // The y-coordinate of END
+    uint64_t seed = 0; // Seed the maze was generated with
+    uint32_t algorithm = ALGORITHM_DFS; // MazeAlgorithm the maze was generated with
+};
+
+/**
+ * @struct MazeFileHeader
+ * @brief On-disk header of a maze file, followed directly by the packed rows of the MazeGrid.
+ *
+ * All fields are stored in host byte order. The header is 64 bytes long, so the body starts 8-byte aligned
+ * and a memory-mapped file can be used as MazeGrid storage as is.
+ */
+struct MazeFileHeader {
+    char magic[8]; // MAZE_FILE_MAGIC
+    uint32_t version; // MAZE_FILE_VERSION
+    uint32_t size; // The size (width and height) of the maze
+    uint32_t startX, startY; // Coordinates of START
+    uint32_t endX, endY; // Coordinates of END
+    uint64_t seed; // Seed the maze was generated with
+    uint32_t algorithm; // MazeAlgorithm the maze was generated with
+    uint32_t rowWords; // Number of 64-bit words per row
+    uint64_t reserved[2]; // Zero, reserved for future use
+};
+
+static_assert(sizeof(MazeFileHeader) == 64, "MazeFileHeader must stay 64 bytes");
+
+/**
+ * @brief Checks that a maze description read from a file can be used.
+ *
+ * @param info The description to check.
+ * @return bool - True if the size is odd and between MIN_MAZE and MAX_MAZE, START and END lie inside
+ *                the maze and the algorithm is known, false otherwise.
+ */
+bool isValidMazeInfo(const MazeFileInfo& info);
+
+/**
+ * @brief Fills the header describing a maze, the packed rows of the grid follow it on disk.
+ *
+ * @param header The header to fill, every field including the reserved ones is overwritten.
+ * @param maze The maze grid.
+ * @param info Description of the maze, its size must match the grid.
+ */
+void fillMazeFileHeader(MazeFileHeader& header, const MazeGrid& maze, const MazeFileInfo& info);
+
+/**
+ * @brief Fills the header of a maze that is written row by row without a MazeGrid.
+ *
+ * @param header The header to fill, every field including the reserved ones is overwritten.
+ * @param info Description of the maze, its size sets the number of words per row.
+ */
+void fillMazeFileHeader(MazeFileHeader& header, const MazeFileInfo& info);
+
+/**
+ * @brief Writes a maze to a binary maze file.
+ *
+ * @param path Path of the file to write.
+ * @param maze The maze grid.
+ * @param info Description of the maze, its size must match the grid.
+ * @return bool - True if the file was written, false otherwise.
+ */
+bool saveMazeFile(const std::string& path, const MazeGrid& maze, const MazeFileInfo& info);
+
+/**
+ * @brief Maps a binary maze file into memory and wraps it in a MazeGrid without copying the cells.
+ *
+ * The mapping is private, so the file on disk never changes and pages are only copied if the grid is modified.
+ *
+ * @param path Path of the file to load.
+ * @param info Receives the description of the maze.
+ * @return std::shared_ptr<MazeGrid> - The maze grid, or nullptr if the file is missing or invalid.
+ */
+std::shared_ptr<MazeGrid> loadMazeFile(const std::string& path, MazeFileInfo& info);
@@ -1,86 +1,65 @@
 #include "MazeGenerator.h"
 
-MazeGenerator::MazeGenerator(int size, int x, int y): size(size), startX(x), startY(y), maze(size, std::vector<CellType>(size, WALL)) {
-    generateMaze(startX, startY);
-    maze[startX][startY] = START;
-    maze[size-1][size-(startY+1)] = END;
-    printMaze();
-}
-
-bool MazeGenerator::isValidPosition(int x, int y) {
-    return x >= 0 && x < size && y >= 0 && y < size && maze[x][y] == WALL;
-}
-
-bool MazeGenerator::hasThreeWalls(int x, int y) {
-    int walls = 0;
-    if (x > 0 && maze[x - 1][y] == PATH)
-        walls++;
-    if (x < size - 1 && maze[x + 1][y] == PATH)
-        walls++;
-    if (y > 0 && maze[x][y - 1] == PATH)
-        walls++;
-    if (y < size - 1 && maze[x][y + 1] == PATH)
-        walls++;
-
-    return walls >= 3;
-}
-
-void MazeGenerator::generateMaze(int x, int y) {
-    // Define possible movement directions
-    int dirX[] = {0, 0, 1, -1};
-    int dirY[] = {1, -1, 0, 0};
-
-    maze[x][y] = PATH; // Mark the current cell as a path
-
-    // Randomize the order of directions for exploration
-    for (int i = 0; i < 4; ++i) {
-        int randomIndex = rand() % 4;
-        int tmp = dirX[i];
-        dirX[i] = dirX[randomIndex];
-        dirX[randomIndex] = tmp;
-
-        tmp = dirY[i];
-        dirY[i] = dirY[randomIndex];
-        dirY[randomIndex] = tmp;
-    }
-
-    // Explore in randomized directions
-    for (int i = 0; i < 4; ++i) {
-        int newX = x + 2 * dirX[i];
-        int newY = y + 2 * dirY[i];
-
-        if (isValidPosition(newX, newY) && !hasThreeWalls(newX, newY)) {
-            // Carve a path to the new position and continue the generation recursively
-            maze[x + dirX[i]][y + dirY[i]] = PATH;
-            generateMaze(newX, newY);
-        }
+MazeGenerator::MazeGenerator(int size, int x, int y, uint64_t seed, bool print):
+    size(size),
+    startX(x),
+    startY(y),
+    seed(seed),
+    maze(std::make_shared<MazeGrid>(size, WALL))
+{
+    DfsPolicy(startX, startY).carve(*maze, seed);
+    maze->set(startX, startY, START);
+    maze->set(size-1, size-(startY+1), END);
+    if (print) {
+        printMaze();
     }
 }
 
-void MazeGenerator::printMaze() {    
-    std::cout << "MAP OF THE MAZE: " << std::endl;
+void MazeGenerator::printMaze() {
+    // One write per row and a single flush at the end, large mazes print in a fraction of the time
+    std::string line;
+    line.reserve(2 * static_cast<size_t>(size) + 2);
+    std::cout << "MAP OF THE MAZE: \n";
     for (int i = 0; i < size; i++) {
-        std::cout << "\t";
+        line.assign(1, '\t');
         for (int j = 0; j < size; j++) {
-            switch (maze[i][j]) {
+            switch (maze->get(i, j)) {
                 case WALL:
-                    std::cout << "# ";
+                    line += "# ";
                     break;
                 case PATH:
-                    std::cout << "  ";
+                    line += "  ";
                     break;
                 case START:
-                    std::cout << "S ";
+                    line += "S ";
                     break;
                 case END:
-                    std::cout << "D ";
+                    line += "D ";
                     break;
             }
         }
-        std::cout << std::endl;
+        line += '\n';
+        std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
     }
+    std::cout.flush();
 }
 
-std::vector<std::vector<CellType>> MazeGenerator::getMaze() {
+std::shared_ptr<const MazeGrid> MazeGenerator::getMaze() const {
     return maze;
-}
\ No newline at end of file
+}
+
+bool MazeGenerator::saveMaze(const std::string& path) const {
+    MazeFileInfo info;
+    info.size = size;
+    info.startX = startX;
+    info.startY = startY;
+    info.endX = size-1;
+    info.endY = size-(startY+1);
+    info.seed = seed;
+    info.algorithm = ALGORITHM_DFS;
+    return saveMazeFile(path, *maze, info);
+}
+
+std::shared_ptr<const MazeGrid> MazeGenerator::loadMaze(const std::string& path, MazeFileInfo& info) {
+    return loadMazeFile(path, info);
+}
@@ -0,0 +1,18 @@
+#include "MazeGrid.h"
+
+MazeGrid::MazeGrid(int size, CellType fill): size(size), rowWords(getRowWords(size)) {
+    // Replicate the 2-bit pattern of the fill type over a whole word
+    uint64_t pattern = 0;
+    for (int i = 0; i < CELLS_PER_WORD; i++) {
+        pattern |= uint64_t(fill) << (2 * i);
+    }
+    storage.assign(rowWords * static_cast<size_t>(size), pattern);
+    words = storage.data();
+}
+
+MazeGrid::MazeGrid(int size, uint64_t* words, std::shared_ptr<void> owner):
+    size(size),
+    rowWords(getRowWords(size)),
+    words(words),
+    owner(owner)
+{ }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum CellType {
+    PATH,
+    WALL,
+    START, // Represents the starting point in the maze
+    END // Represents the finishing point in the maze
+};
+
+/**
+ * @class MazeGrid
+ * @brief Square maze stored as one contiguous bit-packed array with 2 bits per cell.
+ *
+ * Cells are indexed as (x, y) in row-major order, x selecting the row and y the column.
+ * Every row starts on a fresh 64-bit word, so rows can be processed independently.
+ * The grid is shared through std::shared_ptr by the generator, the scene builder and the camera controller,
+ * so the maze lives in memory exactly once. The cells either live in memory owned by the grid
+ * or in an external buffer, such as a memory-mapped maze file.
+ */
+class MazeGrid {
+public:
+    static const int CELLS_PER_WORD = 32; // Number of 2-bit cells packed into one 64-bit word
+
+    /**
+     * @brief Constructor for MazeGrid.
+     *
+     * @param size The size (width and height) of the maze.
+     * @param fill The CellType every cell is initialized with.
+     */
+    MazeGrid(int size, CellType fill = WALL);
+
+    /**
+     * @brief Constructor for MazeGrid viewing an external buffer without copying it.
+     *
+     * @param size The size (width and height) of the maze.
+     * @param words The packed cells, size * getRowWords(size) words laid out like getRow().
+     * @param owner Keeps the buffer alive for as long as the grid exists.
+     */
+    MazeGrid(int size, uint64_t* words, std::shared_ptr<void> owner);
+
+    MazeGrid(const MazeGrid&) = delete;
+    MazeGrid& operator=(const MazeGrid&) = delete;
+
+    /**
+     * @brief Gets the number of 64-bit words a row of a maze of the given size occupies.
+     *
+     * @param size The size (width and height) of the maze.
+     * @return size_t - The row stride in words.
+     */
+    static size_t getRowWords(int size) { return (static_cast<size_t>(size) + CELLS_PER_WORD - 1) / CELLS_PER_WORD; }
+
+    /**
+     * @brief Gets the size of the maze.
+     *
+     * @return int - The size (width and height) of the maze.
+     */
+    int getSize() const { return size; }
+
+    /**
+     * @brief Checks if the given coordinates lie within the maze.
+     *
+     * @param x The x-coordinate to check.
+     * @param y The y-coordinate to check.
+     * @return bool - True if the coordinates are inside the maze, false otherwise.
+     */
+    bool contains(int x, int y) const { return x >= 0 && x < size && y >= 0 && y < size; }
+
+    /**
+     * @brief Gets the type of the cell at the given coordinates.
+     *
+     * @param x The x-coordinate of the cell, must be within the maze.
+     * @param y The y-coordinate of the cell, must be within the maze.
+     * @return CellType - The type of the cell.
+     */
+    CellType get(int x, int y) const {
+        return static_cast<CellType>((words[wordIndex(x, y)] >> bitOffset(y)) & 3);
+    }
+
+    /**
+     * @brief Sets the type of the cell at the given coordinates.
+     *
+     * @param x The x-coordinate of the cell, must be within the maze.
+     * @param y The y-coordinate of the cell, must be within the maze.
+     * @param type The new type of the cell.
+     */
+    void set(int x, int y, CellType type) {
+        uint64_t& word = words[wordIndex(x, y)];
+        word = (word & ~(uint64_t(3) << bitOffset(y))) | (uint64_t(type) << bitOffset(y));
+    }
+
+    /**
+     * @brief Gets the number of 64-bit words occupied by one row.
+     *
+     * @return size_t - The row stride in words.
+     */
+    size_t getRowWords() const { return rowWords; }
+
+    /**
+     * @brief Gets the packed words of a single row.
+     *
+     * @param x The row index.
+     * @return const uint64_t* - Pointer to the first word of the row.
+     */
+    const uint64_t* getRow(int x) const { return words + static_cast<size_t>(x) * rowWords; }
+
+    /**
+     * @brief Gets the number of bytes used by the cell storage.
+     *
+     * @return size_t - Size of the packed cell array in bytes.
+     */
+    size_t getMemoryUsage() const { return static_cast<size_t>(size) * rowWords * sizeof(uint64_t); }
+
+private:
+    int size; // The size (width and height) of the maze
+    size_t rowWords; // Number of 64-bit words per row
+    std::vector<uint64_t> storage; // Owned cell storage, empty when viewing an external buffer
+    uint64_t* words; // Packed cells, 2 bits each
+    std::shared_ptr<void> owner; // Keeps an external buffer alive
+
+    size_t wordIndex(int x, int y) const {
+        return static_cast<size_t>(x) * rowWords + static_cast<size_t>(y) / CELLS_PER_WORD;
+    }
+
+    static int bitOffset(int y) { return (y % CELLS_PER_WORD) * 2; }
+};
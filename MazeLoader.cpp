@@ -0,0 +1,227 @@
+#include "MazeLoader.h"
+
+MazeLoader::MazeLoader(int size, int endX, int endY, TextureRegistry& textures, uint64_t seed,
+                       osgUtil::IncrementalCompileOperation* compileOperation, bool paged, unsigned threads):
+    size(size),
+    endX(endX),
+    endY(endY),
+    textures(textures),
+    seed(seed),
+    compileOperation(compileOperation),
+    paged(paged),
+    threads(threads),
+    chunksPerSide((size + CHUNK_SIZE - 1) / CHUNK_SIZE),
+    chunkGroup(new osg::Group),
+    handle(new LoaderHandle(this)),
+    nextChunk(0),
+    attachedChunks(0),
+    cancelled(false),
+    visibilityInstalled(false),
+    pagerAttached(false)
+{
+    if (this->threads == 0) {
+        this->threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    }
+
+    // Empty placeholders keep every chunk at its index until the real chunk replaces it
+    for (int i = 0; i < chunksPerSide * chunksPerSide && !paged; i++) {
+        chunkGroup->addChild(new osg::Geode);
+    }
+}
+
+MazeLoader::~MazeLoader() {
+    cancelled = true;
+    if (coordinator.joinable()) {
+        coordinator.join();
+    }
+
+    // Chunks still queued are not compiled anymore, a callback already underway waits for the lock and then drops its chunk
+    {
+        std::lock_guard<std::mutex> lock(handle->mutex);
+        handle->loader = nullptr;
+    }
+    for (auto& compileSet : compileSets) {
+        compileOperation->remove(compileSet.get());
+    }
+}
+
+void MazeLoader::start(GridSource source, int startX, int startY) {
+    coordinator = std::thread(&MazeLoader::run, this, source, startX, startY);
+}
+
+osg::Group* MazeLoader::getChunkGroup() const {
+    return chunkGroup.get();
+}
+
+std::shared_ptr<const MazeGrid> MazeLoader::getGrid() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return grid;
+}
+
+std::shared_ptr<const DistanceField> MazeLoader::getDistanceField() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return distanceField;
+}
+
+std::shared_ptr<const MazeOverview> MazeLoader::getOverview() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return overview;
+}
+
+bool MazeLoader::update() {
+    if (paged) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!pagerAttached && pager) {
+            chunkGroup->addChild(pager->getRoot());
+            pagerAttached = true;
+        }
+        return pagerAttached && distanceField;
+    }
+
+    std::vector<std::pair<unsigned, osg::ref_ptr<osg::Node>>> chunks;
+    std::shared_ptr<MazeVisibility> visible;
+    bool distancesReady;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks.swap(builtChunks);
+        visible = visibility;
+        distancesReady = static_cast<bool>(distanceField);
+    }
+
+    for (auto& chunk : chunks) {
+        attachChunk(chunk.first, chunk.second.get());
+    }
+
+    if (!visibilityInstalled && visible) {
+        chunkGroup->setCullCallback(new VisibilityCullCallback(visible));
+        visibilityInstalled = true;
+    }
+
+    return visibilityInstalled && distancesReady && attachedChunks == chunkGroup->getNumChildren();
+}
+
+std::string MazeLoader::getProgressText() const {
+    if (!getGrid() || paged) {
+        return "GENERATING MAZE...";
+    }
+    std::ostringstream text;
+    text << "BUILDING MAZE " << attachedChunks * 100 / chunkGroup->getNumChildren() << "%";
+    return text.str();
+}
+
+void MazeLoader::printStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (meshBuilder) {
+        meshBuilder->printStats();
+    }
+    if (pager) {
+        pager->printStats();
+    }
+    textures.printStats();
+    if (visibility) {
+        visibility->printStats();
+    }
+    if (distanceField) {
+        distanceField->printStats();
+    }
+    if (overview) {
+        overview->printStats();
+    }
+}
+
+bool MazeLoader::AttachChunkCallback::compileCompleted(osgUtil::IncrementalCompileOperation::CompileSet* compileSet) {
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    if (handle->loader) {
+        handle->loader->attachChunk(index, compileSet->_subgraphToCompile.get());
+    }
+    return true;
+}
+
+void MazeLoader::run(GridSource source, int startX, int startY) {
+    std::shared_ptr<const MazeGrid> newGrid = source();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        grid = newGrid;
+        if (paged) {
+            pager.reset(new MazePager(newGrid, textures, seed));
+        } else {
+            meshBuilder.reset(new MazeMeshBuilder(newGrid, textures, seed));
+        }
+    }
+    if (paged) {
+        // The DatabasePager builds the chunks from here on, only the distances and the overview are left.
+        // The dense field of a maze too large to build in full would not fit in memory either.
+        std::shared_ptr<const DistanceField> newDistanceField = std::make_shared<CompactDistanceField>(newGrid, endX, endY);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            distanceField = newDistanceField;
+        }
+        std::shared_ptr<const MazeOverview> newOverview = std::make_shared<MazeOverview>(newGrid);
+        std::lock_guard<std::mutex> lock(mutex);
+        overview = newOverview;
+        return;
+    }
+
+    // Build outwards from the start so the player's surroundings appear first
+    int startChunkX = startX / CHUNK_SIZE, startChunkY = startY / CHUNK_SIZE;
+    chunkOrder.resize(static_cast<size_t>(chunksPerSide) * chunksPerSide);
+    for (unsigned i = 0; i < chunkOrder.size(); i++) {
+        chunkOrder[i] = i;
+    }
+    std::stable_sort(chunkOrder.begin(), chunkOrder.end(), [&](unsigned a, unsigned b) {
+        int ringA = std::max(std::abs(static_cast<int>(a) / chunksPerSide - startChunkX), std::abs(static_cast<int>(a) % chunksPerSide - startChunkY));
+        int ringB = std::max(std::abs(static_cast<int>(b) / chunksPerSide - startChunkX), std::abs(static_cast<int>(b) % chunksPerSide - startChunkY));
+        return ringA < ringB;
+    });
+
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back(&MazeLoader::buildChunks, this);
+    }
+
+    // The culling sets, the distances and the overview only need the grid, compute them while the chunks are built
+    std::shared_ptr<MazeVisibility> newVisibility = std::make_shared<MazeVisibility>(newGrid);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        visibility = newVisibility;
+    }
+    std::shared_ptr<const DistanceField> newDistanceField = std::make_shared<MazeDistanceField>(newGrid, endX, endY);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        distanceField = newDistanceField;
+    }
+    std::shared_ptr<const MazeOverview> newOverview = std::make_shared<MazeOverview>(newGrid);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        overview = newOverview;
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void MazeLoader::buildChunks() {
+    for (unsigned i = nextChunk++; i < chunkOrder.size() && !cancelled; i = nextChunk++) {
+        unsigned index = chunkOrder[i];
+        osg::ref_ptr<osg::Node> chunk = meshBuilder->buildChunk(static_cast<int>(index) / chunksPerSide, static_cast<int>(index) % chunksPerSide);
+
+        if (compileOperation.valid()) {
+            osg::ref_ptr<osgUtil::IncrementalCompileOperation::CompileSet> compileSet =
+                new osgUtil::IncrementalCompileOperation::CompileSet(chunk.get());
+            compileSet->_compileCompletedCallback = new AttachChunkCallback(handle.get(), index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                compileSets.push_back(compileSet);
+            }
+            compileOperation->add(compileSet.get());
+        } else {
+            std::lock_guard<std::mutex> lock(mutex);
+            builtChunks.push_back(std::make_pair(index, chunk));
+        }
+    }
+}
+
+void MazeLoader::attachChunk(unsigned index, osg::Node* chunk) {
+    chunkGroup->setChild(index, chunk);
+    attachedChunks++;
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <osg/Geode>
+#include <osg/Group>
+#include <osgUtil/IncrementalCompileOperation>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "MazeGrid.h"
+#include "MazeMeshBuilder.h"
+#include "MazeVisibility.h"
+#include "MazeDistanceField.h"
+#include "MazePager.h"
+#include "MazeOverview.h"
+#include "TextureRegistry.h"
+
+/**
+ * @class MazeLoader
+ * @brief Generates and meshes the maze on worker threads while the viewer keeps rendering.
+ *
+ * The chunk group is created up front with an empty placeholder per chunk, so chunk indices stay valid
+ * for the visibility callback while real chunks replace the placeholders as they are built. Chunks near
+ * the start are built first. Finished chunks go through osgUtil::IncrementalCompileOperation, which
+ * uploads their buffers and textures a few per frame and attaches them during the update traversal,
+ * so the main thread never stalls on a large upload.
+ *
+ * In paged mode no chunk is built up front: the group receives a MazePager scene once the grid exists and
+ * the DatabasePager builds the chunks around the camera. The visible sets are skipped in this mode, their
+ * cost grows with the maze while the view distance already bounds what is drawn, and the hints use a
+ * CompactDistanceField instead of the dense MazeDistanceField.
+ */
+class MazeLoader {
+public:
+    typedef std::function<std::shared_ptr<const MazeGrid>()> GridSource; // Produces the maze grid, runs on a worker
+
+    /**
+     * @brief Constructor for MazeLoader.
+     *
+     * @param size The size (width and height) of the maze.
+     * @param endX The x-coordinate of the exit.
+     * @param endY The y-coordinate of the exit.
+     * @param textures Registry providing the shared textures.
+     * @param seed The seed of the texture choices.
+     * @param compileOperation Compiles finished chunks and attaches them, null to attach them in update().
+     * @param paged Whether to stream the chunks with MazePager instead of building all of them.
+     * @param threads Number of threads building chunks, 0 to leave one hardware thread to the viewer.
+     */
+    MazeLoader(int size, int endX, int endY, TextureRegistry& textures, uint64_t seed,
+               osgUtil::IncrementalCompileOperation* compileOperation, bool paged = false, unsigned threads = 0);
+
+    /**
+     * @brief Destructor for MazeLoader, stops building chunks and waits for the workers.
+     */
+    ~MazeLoader();
+
+    /**
+     * @brief Starts the pipeline on worker threads.
+     *
+     * @param source Function producing the maze grid.
+     * @param startX The x-coordinate of the starting point, chunks around it are built first.
+     * @param startY The y-coordinate of the starting point.
+     */
+    void start(GridSource source, int startX, int startY);
+
+    /**
+     * @brief Gets the group holding one child per chunk, ordered by chunk index.
+     *
+     * @return osg::Group* - The chunk group.
+     */
+    osg::Group* getChunkGroup() const;
+
+    /**
+     * @brief Gets the maze grid.
+     *
+     * @return std::shared_ptr<const MazeGrid> - The grid, null until it has been produced.
+     */
+    std::shared_ptr<const MazeGrid> getGrid() const;
+
+    /**
+     * @brief Gets the distance field of the maze.
+     *
+     * @return std::shared_ptr<const DistanceField> - The field, null until it has been computed.
+     */
+    std::shared_ptr<const DistanceField> getDistanceField() const;
+
+    /**
+     * @brief Gets the single-quad overview of the maze, for viewing all of it from far away.
+     *
+     * @return std::shared_ptr<const MazeOverview> - The overview, null until it has been rendered.
+     */
+    std::shared_ptr<const MazeOverview> getOverview() const;
+
+    /**
+     * @brief Applies finished work to the scene, called from the main loop between frames.
+     *
+     * @return bool - True once every chunk is attached, the visibility culling is installed and the distance
+     *                field is computed, or once the paged scene is attached and the distance field is computed
+     *                in paged mode.
+     */
+    bool update();
+
+    /**
+     * @brief Gets a description of the current stage for the loading screen.
+     *
+     * @return std::string - The progress text.
+     */
+    std::string getProgressText() const;
+
+    /**
+     * @brief Prints the statistics of the mesh and the texture array.
+     */
+    void printStats() const;
+
+protected:
+    /**
+     * @class LoaderHandle
+     * @brief Reference-counted link from the compile callbacks to the loader, cleared when the loader is destroyed.
+     */
+    class LoaderHandle : public osg::Referenced {
+    public:
+        LoaderHandle(MazeLoader* loader): loader(loader) { }
+
+        std::mutex mutex; // Held while the loader is used or cleared
+        MazeLoader* loader; // The loader, null once it is destroyed
+    };
+
+    /**
+     * @class AttachChunkCallback
+     * @brief Puts a compiled chunk in place of its placeholder, runs in the update traversal.
+     *
+     * The IncrementalCompileOperation may still hold the callback after the loader is gone, so it reaches the
+     * loader through a LoaderHandle and drops the chunk once the handle is cleared.
+     */
+    class AttachChunkCallback : public osgUtil::IncrementalCompileOperation::CompileCompletedCallback {
+    public:
+        AttachChunkCallback(LoaderHandle* handle, unsigned index): handle(handle), index(index) { }
+
+        virtual bool compileCompleted(osgUtil::IncrementalCompileOperation::CompileSet* compileSet);
+
+    protected:
+        osg::ref_ptr<LoaderHandle> handle; // Link to the loader owning the chunk group
+        unsigned index; // Index of the chunk in the group
+    };
+
+    int size; // The size (width and height) of the maze
+    int endX; // The x-coordinate of the exit
+    int endY; // The y-coordinate of the exit
+    TextureRegistry& textures; // Registry providing the shared textures
+    uint64_t seed; // The seed of the texture choices
+    osg::ref_ptr<osgUtil::IncrementalCompileOperation> compileOperation; // Spreads uploads over frames, may be null
+    bool paged; // Whether the chunks are streamed by MazePager
+    unsigned threads; // Number of threads building chunks
+    int chunksPerSide; // Number of chunks along each side of the maze
+    osg::ref_ptr<osg::Group> chunkGroup; // One child per chunk, placeholders until the chunk is attached
+    osg::ref_ptr<LoaderHandle> handle; // Shared with the compile callbacks
+
+    mutable std::mutex mutex; // Guards the members below that are shared with the workers
+    std::shared_ptr<const MazeGrid> grid; // The maze grid, null until produced
+    std::unique_ptr<MazeMeshBuilder> meshBuilder; // Builds the chunks, created with the grid
+    std::unique_ptr<MazePager> pager; // Paged scene, created with the grid in paged mode
+    std::shared_ptr<MazeVisibility> visibility; // Visible sets, null until computed
+    std::shared_ptr<const DistanceField> distanceField; // Distances to the exit, null until computed
+    std::shared_ptr<const MazeOverview> overview; // Map of the whole maze, null until rendered
+    std::vector<std::pair<unsigned, osg::ref_ptr<osg::Node>>> builtChunks; // Chunks waiting for update() without a compile operation
+    std::vector<osg::ref_ptr<osgUtil::IncrementalCompileOperation::CompileSet>> compileSets; // Sets given to the compile operation
+
+    std::vector<unsigned> chunkOrder; // Chunk indices sorted by distance from the start
+    std::atomic<unsigned> nextChunk; // Position in chunkOrder of the next chunk to build
+    std::atomic<unsigned> attachedChunks; // Number of chunks attached to the group
+    std::atomic<bool> cancelled; // Set when the loader is destroyed before finishing
+    bool visibilityInstalled; // True once the cull callback is set, only used by the main thread
+    bool pagerAttached; // True once the paged scene is in the group, only used by the main thread
+    std::thread coordinator; // Runs the pipeline stages
+    std::vector<std::thread> workers; // Build chunks
+
+    /**
+     * @brief Produces the grid, starts the chunk workers and computes the visibility and distance field.
+     *
+     * @param source Function producing the maze grid.
+     * @param startX The x-coordinate of the starting point.
+     * @param startY The y-coordinate of the starting point.
+     */
+    void run(GridSource source, int startX, int startY);
+
+    /**
+     * @brief Builds chunks in chunkOrder until none are left, runs on every worker.
+     */
+    void buildChunks();
+
+    /**
+     * @brief Replaces the placeholder of a chunk, runs on the main thread.
+     *
+     * @param index Index of the chunk in the group.
+     * @param chunk The built chunk.
+     */
+    void attachChunk(unsigned index, osg::Node* chunk);
+};
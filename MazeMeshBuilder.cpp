@@ -0,0 +1,182 @@
+#include "MazeMeshBuilder.h"
+
+namespace {
+
+/**
+ * @struct BoxFace
+ * @brief One quad of the unit cell box, corners listed with texture coordinates (0,1), (0,0), (1,0), (1,1).
+ */
+struct BoxFace {
+    float normal[3];
+    float corners[4][3];
+};
+
+// Faces of a unit box standing on the ground, laid out like the osg::ShapeDrawable box it replaces
+enum BoxFaceIndex { FACE_NEG_Y, FACE_POS_Y, FACE_POS_X, FACE_NEG_X, FACE_TOP, FACE_BOTTOM, FACE_FLOOR };
+
+const BoxFace boxFaces[] = {
+    {{ 0.0f, -1.0f,  0.0f}, {{-0.5f, -0.5f, 1.0f}, {-0.5f, -0.5f, 0.0f}, { 0.5f, -0.5f, 0.0f}, { 0.5f, -0.5f, 1.0f}}},
+    {{ 0.0f,  1.0f,  0.0f}, {{ 0.5f,  0.5f, 1.0f}, { 0.5f,  0.5f, 0.0f}, {-0.5f,  0.5f, 0.0f}, {-0.5f,  0.5f, 1.0f}}},
+    {{ 1.0f,  0.0f,  0.0f}, {{ 0.5f, -0.5f, 1.0f}, { 0.5f, -0.5f, 0.0f}, { 0.5f,  0.5f, 0.0f}, { 0.5f,  0.5f, 1.0f}}},
+    {{-1.0f,  0.0f,  0.0f}, {{-0.5f,  0.5f, 1.0f}, {-0.5f,  0.5f, 0.0f}, {-0.5f, -0.5f, 0.0f}, {-0.5f, -0.5f, 1.0f}}},
+    {{ 0.0f,  0.0f,  1.0f}, {{-0.5f,  0.5f, 1.0f}, {-0.5f, -0.5f, 1.0f}, { 0.5f, -0.5f, 1.0f}, { 0.5f,  0.5f, 1.0f}}},
+    {{ 0.0f,  0.0f, -1.0f}, {{ 0.5f,  0.5f, 0.0f}, { 0.5f, -0.5f, 0.0f}, {-0.5f, -0.5f, 0.0f}, {-0.5f,  0.5f, 0.0f}}},
+    {{ 0.0f,  0.0f,  1.0f}, {{-0.5f,  0.5f, 0.0f}, {-0.5f, -0.5f, 0.0f}, { 0.5f, -0.5f, 0.0f}, { 0.5f,  0.5f, 0.0f}}},
+};
+
+const float faceTexCoords[4][2] = {{0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}};
+
+// Every chunk must stay addressable with 16-bit indices
+static_assert(CHUNK_SIZE * CHUNK_SIZE * 6 * 4 <= 65536, "CHUNK_SIZE too large for 16-bit indices");
+
+}
+
+MazeMeshBuilder::MazeMeshBuilder(std::shared_ptr<const MazeGrid> maze, TextureRegistry& textures, uint64_t seed):
+    maze(maze),
+    textures(textures),
+    seed(seed),
+    builtChunks(0),
+    builtGeometries(0),
+    fullTriangles(0),
+    emittedTriangles(0)
+{ }
+
+osg::Group* MazeMeshBuilder::buildMaze() {
+    osg::ref_ptr<osg::Group> scn = new osg::Group;
+    int chunks = getChunksPerSide();
+    for (int cx = 0; cx < chunks; cx++) {
+        for (int cy = 0; cy < chunks; cy++) {
+            scn->addChild(buildChunk(cx, cy));
+        }
+    }
+
+    return scn.release();
+}
+
+osg::Geode* MazeMeshBuilder::buildChunk(int chunkX, int chunkY) {
+    int size = maze->getSize();
+    int beginX = chunkX * CHUNK_SIZE, endX = std::min(beginX + CHUNK_SIZE, size);
+    int beginY = chunkY * CHUNK_SIZE, endY = std::min(beginY + CHUNK_SIZE, size);
+
+    // Every cell of the chunk goes into one mesh, the texture array layer travels with the vertices.
+    // Each chunk has its own random stream, so the textures do not depend on which thread builds it.
+    MeshData mesh;
+    Random rng(mixSeed(seed, static_cast<uint64_t>(chunkX) * getChunksPerSide() + chunkY));
+    const int endLayer = static_cast<int>(textureWeights.size()); // MAZE_END_TEXTURE is the last layer
+    for (int i = beginX; i < endX; i++) {
+        for (int j = beginY; j < endY; j++) {
+            CellType cell = maze->get(i, j);
+            if (cell == WALL) {
+                addWall(mesh, i, j, getRandomTextureIndex(rng));
+            } else if (cell == END) {
+                addWall(mesh, i, j, endLayer);
+            } else {
+                addFloor(mesh, i, j, getRandomTextureIndex(rng));
+            }
+        }
+    }
+
+    osg::ref_ptr<osg::Geode> chunk = new osg::Geode;
+    size_t chunkTriangles = 0;
+    if (mesh.indices.valid()) {
+        chunk->addDrawable(createGeometry(mesh, textures.getTextureArrayStateSet()));
+        chunkTriangles = mesh.indices->size() / 3;
+    }
+    chunk->setDataVariance(osg::Object::STATIC);
+
+    // Counters are shared by all threads building chunks, update them once per chunk
+    builtChunks++;
+    builtGeometries += chunk->getNumDrawables();
+    fullTriangles += mesh.fullTriangles;
+    emittedTriangles += chunkTriangles;
+
+    return chunk.release();
+}
+
+int MazeMeshBuilder::getChunksPerSide() const {
+    return (maze->getSize() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+int MazeMeshBuilder::getChunkIndex(int x, int y) const {
+    return (x / CHUNK_SIZE) * getChunksPerSide() + y / CHUNK_SIZE;
+}
+
+unsigned MazeMeshBuilder::getBuiltChunkCount() const {
+    return builtChunks.load();
+}
+
+size_t MazeMeshBuilder::getFullTriangleCount() const {
+    return fullTriangles.load();
+}
+
+size_t MazeMeshBuilder::getTriangleCount() const {
+    return emittedTriangles.load();
+}
+
+void MazeMeshBuilder::printStats() const {
+    std::cout << "MAZE MESH: " << builtChunks.load() << " chunks, " << builtGeometries.load() << " geometries, "
+              << emittedTriangles.load() << " triangles (" << fullTriangles.load() << " without hidden-face elimination)" << std::endl;
+}
+
+bool MazeMeshBuilder::isSolid(int x, int y) const {
+    if (!maze->contains(x, y)) {
+        return false; // The outer faces of the border walls are seen when orbiting the maze on the end screen
+    }
+    CellType cell = maze->get(x, y);
+    return cell == WALL || cell == END;
+}
+
+void MazeMeshBuilder::addWall(MeshData& mesh, int x, int y, int layer) {
+    osg::Vec3 offset(static_cast<float>(x), static_cast<float>(y), 0.0f);
+    mesh.fullTriangles += 12;
+
+    // The bottom face always rests on the ground and side faces touching another box are never visible
+    if (!isSolid(x, y - 1)) addFace(mesh, FACE_NEG_Y, offset, layer);
+    if (!isSolid(x, y + 1)) addFace(mesh, FACE_POS_Y, offset, layer);
+    if (!isSolid(x + 1, y)) addFace(mesh, FACE_POS_X, offset, layer);
+    if (!isSolid(x - 1, y)) addFace(mesh, FACE_NEG_X, offset, layer);
+    addFace(mesh, FACE_TOP, offset, layer);
+}
+
+void MazeMeshBuilder::addFloor(MeshData& mesh, int x, int y, int layer) {
+    mesh.fullTriangles += 2;
+    addFace(mesh, FACE_FLOOR, osg::Vec3(static_cast<float>(x), static_cast<float>(y), 0.0f), layer);
+}
+
+void MazeMeshBuilder::addFace(MeshData& mesh, int face, const osg::Vec3& offset, int layer) {
+    if (!mesh.vertices.valid()) {
+        mesh.vertices = new osg::Vec3Array;
+        mesh.normals = new osg::Vec3Array;
+        mesh.texCoords = new osg::Vec3Array;
+        mesh.indices = new osg::DrawElementsUShort(GL_TRIANGLES);
+    }
+
+    const BoxFace& boxFace = boxFaces[face];
+    unsigned short base = static_cast<unsigned short>(mesh.vertices->size());
+    for (int c = 0; c < 4; c++) {
+        mesh.vertices->push_back(offset + osg::Vec3(boxFace.corners[c][0], boxFace.corners[c][1], boxFace.corners[c][2]));
+        mesh.normals->push_back(osg::Vec3(boxFace.normal[0], boxFace.normal[1], boxFace.normal[2]));
+        mesh.texCoords->push_back(osg::Vec3(faceTexCoords[c][0], faceTexCoords[c][1], static_cast<float>(layer)));
+    }
+
+    // Two counter-clockwise triangles per quad
+    const unsigned short quad[] = {0, 1, 2, 0, 2, 3};
+    for (unsigned short index : quad) {
+        mesh.indices->push_back(base + index);
+    }
+}
+
+osg::Geometry* MazeMeshBuilder::createGeometry(MeshData& mesh, osg::StateSet* stateSet) {
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+    geometry->setUseDisplayList(false);
+    geometry->setUseVertexBufferObjects(true);
+    geometry->setDataVariance(osg::Object::STATIC);
+
+    geometry->setVertexArray(mesh.vertices.get());
+    geometry->setNormalArray(mesh.normals.get(), osg::Array::BIND_PER_VERTEX);
+    geometry->setTexCoordArray(0, mesh.texCoords.get(), osg::Array::BIND_PER_VERTEX);
+    geometry->addPrimitiveSet(mesh.indices.get());
+    geometry->setStateSet(stateSet);
+
+    return geometry.release();
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <osg/Geode>
+#include <osg/Group>
+#include <osg/Geometry>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "MazeGrid.h"
+#include "BlockTextures.h"
+#include "TextureRegistry.h"
+
+#define CHUNK_SIZE 32 // Number of cells along each side of a mesh chunk
+
+/**
+ * @class MazeMeshBuilder
+ * @brief Builds the maze scene as merged geometry split into square chunks.
+ *
+ * Every chunk of CHUNK_SIZE x CHUNK_SIZE cells becomes one osg::Geode holding a single osg::Geometry,
+ * so the node and draw call count grows with the number of chunks instead of cells. Textures come from
+ * the registry's texture array, the layer of each cell is stored in the z texture coordinate, and all
+ * chunks share one StateSet.
+ * The geometry matches the former per-cell scene: walls are unit boxes and floors are unit quads.
+ * Only visible wall faces are emitted: top caps and side faces bordering an open cell.
+ * buildChunk() may be called from several threads at once, the TextureRegistry must then be shared safely.
+ */
+class MazeMeshBuilder {
+public:
+    /**
+     * @brief Constructor for MazeMeshBuilder.
+     *
+     * @param maze The shared maze grid.
+     * @param textures Registry providing the shared texture array StateSet.
+     * @param seed The seed of the texture choices, every chunk derives its own stream from it.
+     */
+    MazeMeshBuilder(std::shared_ptr<const MazeGrid> maze, TextureRegistry& textures, uint64_t seed);
+
+    /**
+     * @brief Builds the whole maze.
+     *
+     * @return osg::Group* - Group with one child Geode per chunk, ordered by chunk index.
+     */
+    osg::Group* buildMaze();
+
+    /**
+     * @brief Builds the geometry of a single chunk.
+     *
+     * @param chunkX The x-index of the chunk.
+     * @param chunkY The y-index of the chunk.
+     * @return osg::Geode* - Geode holding the Geometry of the chunk.
+     */
+    osg::Geode* buildChunk(int chunkX, int chunkY);
+
+    /**
+     * @brief Gets the number of chunks along each side of the maze.
+     *
+     * @return int - The number of chunks per side.
+     */
+    int getChunksPerSide() const;
+
+    /**
+     * @brief Gets the index of the chunk containing the specified cell.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return int - The chunk index, matching the child index in buildMaze().
+     */
+    int getChunkIndex(int x, int y) const;
+
+    /**
+     * @brief Gets the number of triangles full boxes would have needed for the walls built so far.
+     *
+     * @return size_t - The triangle count without hidden-face elimination.
+     */
+    size_t getFullTriangleCount() const;
+
+    /**
+     * @brief Gets the number of chunks built so far.
+     *
+     * @return unsigned - The chunk count.
+     */
+    unsigned getBuiltChunkCount() const;
+
+    /**
+     * @brief Gets the number of triangles actually emitted so far.
+     *
+     * @return size_t - The triangle count after hidden-face elimination.
+     */
+    size_t getTriangleCount() const;
+
+    /**
+     * @brief Prints the number of chunks, drawables and triangles built so far.
+     */
+    void printStats() const;
+
+protected:
+    /**
+     * @struct MeshData
+     * @brief Vertex data gathered for one chunk.
+     */
+    struct MeshData {
+        osg::ref_ptr<osg::Vec3Array> vertices; // Vertex positions
+        osg::ref_ptr<osg::Vec3Array> normals; // Per-vertex normals
+        osg::ref_ptr<osg::Vec3Array> texCoords; // Per-vertex texture coordinates, z is the texture array layer
+        osg::ref_ptr<osg::DrawElementsUShort> indices; // Triangle indices
+        size_t fullTriangles = 0; // Triangles the cells would need without hidden-face elimination
+    };
+
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+    TextureRegistry& textures; // Registry providing the shared texture array StateSet
+    uint64_t seed; // The seed of the texture choices
+    std::atomic<unsigned> builtChunks; // Number of chunks built so far
+    std::atomic<unsigned> builtGeometries; // Number of Geometry drawables built so far
+    std::atomic<size_t> fullTriangles; // Triangles needed without hidden-face elimination
+    std::atomic<size_t> emittedTriangles; // Triangles actually emitted
+
+    /**
+     * @brief Checks if the specified cell is rendered as a solid box.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return bool - True for walls and the finishing block, false for paths and cells outside the maze.
+     */
+    bool isSolid(int x, int y) const;
+
+    /**
+     * @brief Appends the visible faces of a wall box centered on the specified cell.
+     *
+     * @param mesh Mesh data of the chunk.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param layer Texture array layer of the wall.
+     */
+    void addWall(MeshData& mesh, int x, int y, int layer);
+
+    /**
+     * @brief Appends a floor quad centered on the specified cell.
+     *
+     * @param mesh Mesh data of the chunk.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param layer Texture array layer of the floor.
+     */
+    void addFloor(MeshData& mesh, int x, int y, int layer);
+
+    /**
+     * @brief Appends one face of the unit box as two triangles.
+     *
+     * @param mesh Mesh data the face is added to.
+     * @param face Index of the face in the box face table.
+     * @param offset Translation of the cell.
+     * @param layer Texture array layer of the face.
+     */
+    void addFace(MeshData& mesh, int face, const osg::Vec3& offset, int layer);
+
+    /**
+     * @brief Creates a static, VBO-backed Geometry from gathered mesh data.
+     *
+     * @param mesh Mesh data of a chunk.
+     * @param stateSet Shared StateSet of the texture array.
+     * @return osg::Geometry* - Pointer to the created geometry.
+     */
+    osg::Geometry* createGeometry(MeshData& mesh, osg::StateSet* stateSet);
+};
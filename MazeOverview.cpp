@@ -0,0 +1,115 @@
+#include "MazeOverview.h"
+
+// Colours of the cell types in the overview, indexed by CellType
+const unsigned char overviewColors[4][3] = {
+    { 40,  40,  40}, // PATH, dark floor
+    {125, 125, 125}, // WALL, stone
+    { 60, 170,  60}, // START
+    { 90, 220, 220}  // END, diamond
+};
+
+MazeOverview::MazeOverview(std::shared_ptr<const MazeGrid> maze):
+    size(maze->getSize()),
+    cellsPerTexel((maze->getSize() + OVERVIEW_MAX_TEXTURE_SIZE - 1) / OVERVIEW_MAX_TEXTURE_SIZE),
+    image(new osg::Image),
+    computeTime(0.0)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    renderImage(*maze);
+    node = createQuad();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    computeTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+osg::Geode* MazeOverview::getNode() const {
+    return node.get();
+}
+
+osg::LOD* MazeOverview::createLod(osg::Node* detail) const {
+    osg::LOD* lod = new osg::LOD;
+    lod->setRangeMode(osg::LOD::DISTANCE_FROM_EYE_POINT);
+    lod->addChild(detail, 0.0f, OVERVIEW_SWITCH_DISTANCE);
+    lod->addChild(node.get(), OVERVIEW_SWITCH_DISTANCE, FLT_MAX);
+    return lod;
+}
+
+void MazeOverview::printStats() const {
+    std::cout << "OVERVIEW: " << image->s() << "x" << image->t() << " texture, " << cellsPerTexel << "x" << cellsPerTexel
+              << " cells per texel, rendered in " << computeTime << " ms" << std::endl;
+}
+
+void MazeOverview::renderImage(const MazeGrid& maze) {
+    int texels = (size + cellsPerTexel - 1) / cellsPerTexel;
+    image->allocateImage(texels, texels, 1, GL_RGB, GL_UNSIGNED_BYTE);
+
+    // Grid rows map to image rows, so one row of texel sums is enough for any maze size
+    std::vector<unsigned> sums(static_cast<size_t>(texels) * 3);
+    std::vector<unsigned> counts(texels);
+    std::vector<unsigned char> hasEnd(texels);
+    for (int t = 0; t < texels; t++) {
+        std::fill(sums.begin(), sums.end(), 0u);
+        std::fill(counts.begin(), counts.end(), 0u);
+        std::fill(hasEnd.begin(), hasEnd.end(), 0);
+        for (int x = t * cellsPerTexel; x < std::min((t + 1) * cellsPerTexel, size); x++) {
+            for (int y = 0; y < size; y++) {
+                CellType type = maze.get(x, y);
+                int s = y / cellsPerTexel;
+                sums[s * 3] += overviewColors[type][0];
+                sums[s * 3 + 1] += overviewColors[type][1];
+                sums[s * 3 + 2] += overviewColors[type][2];
+                counts[s]++;
+                hasEnd[s] |= type == END;
+            }
+        }
+
+        unsigned char* row = image->data(0, t);
+        for (int s = 0; s < texels; s++) {
+            for (int c = 0; c < 3; c++) {
+                // The exit stays visible even when it is averaged with thousands of other cells
+                row[s * 3 + c] = hasEnd[s] ? overviewColors[END][c] : static_cast<unsigned char>(sums[s * 3 + c] / counts[s]);
+            }
+        }
+    }
+    image->dirty();
+}
+
+osg::Geode* MazeOverview::createQuad() const {
+    // The last texel may cover fewer cells, keep the texture coordinates on whole cells
+    float extent = static_cast<float>(size) / (cellsPerTexel * image->s());
+    float low = -0.5f, high = size - 0.5f;
+
+    osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array;
+    vertices->push_back(osg::Vec3(low, low, OVERVIEW_HEIGHT));
+    vertices->push_back(osg::Vec3(high, low, OVERVIEW_HEIGHT));
+    vertices->push_back(osg::Vec3(high, high, OVERVIEW_HEIGHT));
+    vertices->push_back(osg::Vec3(low, high, OVERVIEW_HEIGHT));
+
+    // The image is stored with s along y and t along x of the grid
+    osg::ref_ptr<osg::Vec2Array> texCoords = new osg::Vec2Array;
+    texCoords->push_back(osg::Vec2(0.0f, 0.0f));
+    texCoords->push_back(osg::Vec2(0.0f, extent));
+    texCoords->push_back(osg::Vec2(extent, extent));
+    texCoords->push_back(osg::Vec2(extent, 0.0f));
+
+    osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array;
+    normals->push_back(osg::Vec3(0.0f, 0.0f, 1.0f));
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+    geometry->setVertexArray(vertices.get());
+    geometry->setTexCoordArray(0, texCoords.get());
+    geometry->setNormalArray(normals.get(), osg::Array::BIND_OVERALL);
+    geometry->addPrimitiveSet(new osg::DrawArrays(GL_QUADS, 0, 4));
+
+    // Sharp cell edges up close, mipmaps keep the far view from shimmering
+    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D(image.get());
+    texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_LINEAR);
+    texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+    texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+    texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+    texture->setResizeNonPowerOfTwoHint(false);
+    geometry->getOrCreateStateSet()->setTextureAttributeAndModes(0, texture.get(), osg::StateAttribute::ON);
+
+    osg::Geode* geode = new osg::Geode;
+    geode->addDrawable(geometry.get());
+    return geode;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/LOD>
+#include <osg/Texture2D>
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "MazeGrid.h"
+
+#define OVERVIEW_MAX_TEXTURE_SIZE 4096 // Largest side of the overview texture, larger mazes share texels
+#define OVERVIEW_SWITCH_DISTANCE 150.0f // Distance from the eye to the maze center beyond which the overview is drawn
+#define OVERVIEW_HEIGHT 1.0f // Height of the overview quad, level with the wall tops
+
+/**
+ * @class MazeOverview
+ * @brief Map of the whole maze drawn as a single textured quad, for viewing it from far away.
+ *
+ * Every cell becomes one texel coloured by its type; mazes larger than OVERVIEW_MAX_TEXTURE_SIZE average
+ * square blocks of cells into one texel. The quad lies on the wall tops, so from above it matches the
+ * per-cell geometry while costing one drawable and one texture regardless of the maze size.
+ */
+class MazeOverview {
+public:
+    /**
+     * @brief Constructor for MazeOverview, renders the grid into the overview texture.
+     *
+     * @param maze The shared maze grid.
+     */
+    MazeOverview(std::shared_ptr<const MazeGrid> maze);
+
+    /**
+     * @brief Gets the overview quad.
+     *
+     * @return osg::Geode* - Geode holding the textured quad.
+     */
+    osg::Geode* getNode() const;
+
+    /**
+     * @brief Creates a LOD drawing the detailed scene near the maze and the overview beyond OVERVIEW_SWITCH_DISTANCE.
+     *
+     * @param detail The per-cell scene of the maze.
+     * @return osg::LOD* - The LOD switching between both representations.
+     */
+    osg::LOD* createLod(osg::Node* detail) const;
+
+    /**
+     * @brief Prints the texture size and the time it took to render it.
+     */
+    void printStats() const;
+
+protected:
+    int size; // The size (width and height) of the maze
+    int cellsPerTexel; // Cells along each side of a texel
+    osg::ref_ptr<osg::Image> image; // One texel per block of cells, s along y and t along x of the grid
+    osg::ref_ptr<osg::Geode> node; // The textured quad
+    double computeTime; // Time spent rendering the texture in milliseconds
+
+    /**
+     * @brief Renders the grid into the image, averaging the colours of each block of cells.
+     *
+     * @param maze The maze grid.
+     */
+    void renderImage(const MazeGrid& maze);
+
+    /**
+     * @brief Creates the quad covering the maze with the overview texture.
+     *
+     * @return osg::Geode* - Geode holding the quad.
+     */
+    osg::Geode* createQuad() const;
+};
@@ -0,0 +1,161 @@
+#include "MazePager.h"
+
+namespace {
+
+/**
+ * @class ReaderWriterMaze
+ * @brief Pseudo-loader turning "L_X_Y.mazequad", "X_Y.mazeregion" and "X_Y.mazechunk" requests into nodes built from the grid.
+ */
+class ReaderWriterMaze : public osgDB::ReaderWriter {
+public:
+    ReaderWriterMaze() {
+        supportsExtension("mazequad", "Quad of maze region pages");
+        supportsExtension("mazeregion", "Region of maze chunk pages");
+        supportsExtension("mazechunk", "Maze chunk geometry");
+    }
+
+    virtual const char* className() const { return "Maze pseudo-loader"; }
+
+    virtual ReadResult readNode(const std::string& fileName, const osgDB::Options* options) const {
+        std::string extension = osgDB::getLowerCaseFileExtension(fileName);
+        if (!acceptsExtension(extension)) {
+            return ReadResult::FILE_NOT_HANDLED;
+        }
+
+        MazePager::Source* source = options ? dynamic_cast<MazePager::Source*>(const_cast<osg::Referenced*>(options->getUserData())) : nullptr;
+        int level = 0, x = 0, y = 0;
+        char separator = 0;
+        std::istringstream name(osgDB::getNameLessExtension(fileName));
+        if (extension == "mazequad" && !(name >> level >> separator && separator == '_')) {
+            return ReadResult::FILE_NOT_HANDLED;
+        }
+        if (!source || !(name >> x >> separator >> y) || separator != '_') {
+            return ReadResult::FILE_NOT_HANDLED;
+        }
+
+        osgDB::Options* pageOptions = const_cast<osgDB::Options*>(options);
+        if (extension == "mazequad") {
+            return source->buildQuad(level, x, y, pageOptions);
+        }
+        if (extension == "mazeregion") {
+            return source->buildRegion(x, y, pageOptions);
+        }
+        return source->meshBuilder.buildChunk(x, y);
+    }
+};
+
+/**
+ * @brief Registers the pseudo-loader with the osgDB registry once per process.
+ */
+void registerReaderWriter() {
+    static std::once_flag registered;
+    std::call_once(registered, []() {
+        osgDB::Registry::instance()->addReaderWriter(new ReaderWriterMaze);
+    });
+}
+
+/**
+ * @brief Creates a page covering a square of cells.
+ *
+ * @param fileName Pseudo file name of the page content.
+ * @param beginX The x-coordinate of the first cell.
+ * @param beginY The y-coordinate of the first cell.
+ * @param cells Number of cells along each side of the square.
+ * @param options Database options carrying the source.
+ * @return osg::PagedLOD* - The page.
+ */
+osg::PagedLOD* createPage(const std::string& fileName, int beginX, int beginY, int cells, osgDB::Options* options) {
+    // Children are not loaded yet, so the bounds have to be given explicitly
+    float half = cells / 2.0f;
+    float radius = half * 1.4143f;
+    osg::ref_ptr<osg::PagedLOD> page = new osg::PagedLOD;
+    page->setCenterMode(osg::LOD::USER_DEFINED_CENTER);
+    page->setCenter(osg::Vec3(beginX - 0.5f + half, beginY - 0.5f + half, 0.5f));
+    page->setRadius(radius);
+    page->setFileName(0, fileName);
+    page->setRange(0, 0.0f, PAGED_VIEW_DISTANCE + radius);
+    page->setDatabaseOptions(options);
+    return page.release();
+}
+
+}
+
+MazePager::MazePager(std::shared_ptr<const MazeGrid> maze, TextureRegistry& textures, uint64_t seed):
+    source(new Source(maze, textures, seed)),
+    options(new osgDB::Options),
+    root(new osg::Group),
+    levels(0)
+{
+    registerReaderWriter();
+    options->setUserData(source.get());
+    options->setObjectCacheHint(osgDB::Options::CACHE_NONE);
+
+    // The top quad is the smallest one covering every region, its quarters hang directly under the root
+    while ((1 << levels) < source->regionsPerSide) {
+        levels++;
+    }
+    if (levels == 0) {
+        root->addChild(source->createRegionPage(0, 0, options.get()));
+    } else {
+        root->addChild(source->buildQuad(levels, 0, 0, options.get()));
+    }
+}
+
+osg::Group* MazePager::getRoot() const {
+    return root.get();
+}
+
+void MazePager::printStats() const {
+    std::cout << "PAGED MAZE: " << source->regionsPerSide * source->regionsPerSide << " regions of " << PAGED_REGION_CHUNKS
+              << "x" << PAGED_REGION_CHUNKS << " chunks in a quadtree of " << levels << " levels, view distance "
+              << PAGED_VIEW_DISTANCE << std::endl;
+    source->meshBuilder.printStats();
+}
+
+osg::PagedLOD* MazePager::Source::createChunkPage(int chunkX, int chunkY, osgDB::Options* options) {
+    std::ostringstream fileName;
+    fileName << chunkX << "_" << chunkY << ".mazechunk";
+    return createPage(fileName.str(), chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, CHUNK_SIZE, options);
+}
+
+osg::PagedLOD* MazePager::Source::createRegionPage(int regionX, int regionY, osgDB::Options* options) {
+    std::ostringstream fileName;
+    fileName << regionX << "_" << regionY << ".mazeregion";
+    int cells = PAGED_REGION_CHUNKS * CHUNK_SIZE;
+    return createPage(fileName.str(), regionX * cells, regionY * cells, cells, options);
+}
+
+osg::PagedLOD* MazePager::Source::createQuadPage(int level, int quadX, int quadY, osgDB::Options* options) {
+    std::ostringstream fileName;
+    fileName << level << "_" << quadX << "_" << quadY << ".mazequad";
+    int cells = (PAGED_REGION_CHUNKS * CHUNK_SIZE) << level;
+    return createPage(fileName.str(), quadX * cells, quadY * cells, cells, options);
+}
+
+osg::Group* MazePager::Source::buildQuad(int level, int quadX, int quadY, osgDB::Options* options) {
+    int regionsPerQuarter = 1 << (level - 1);
+    osg::ref_ptr<osg::Group> quad = new osg::Group;
+    for (int qx = 2 * quadX; qx < 2 * quadX + 2; qx++) {
+        for (int qy = 2 * quadY; qy < 2 * quadY + 2; qy++) {
+            if (qx * regionsPerQuarter >= regionsPerSide || qy * regionsPerQuarter >= regionsPerSide) {
+                continue;
+            }
+            quad->addChild(level == 1 ? createRegionPage(qx, qy, options) : createQuadPage(level - 1, qx, qy, options));
+        }
+    }
+    return quad.release();
+}
+
+osg::Group* MazePager::Source::buildRegion(int regionX, int regionY, osgDB::Options* options) {
+    int chunksPerSide = meshBuilder.getChunksPerSide();
+    int beginX = regionX * PAGED_REGION_CHUNKS, endX = std::min(beginX + PAGED_REGION_CHUNKS, chunksPerSide);
+    int beginY = regionY * PAGED_REGION_CHUNKS, endY = std::min(beginY + PAGED_REGION_CHUNKS, chunksPerSide);
+
+    osg::ref_ptr<osg::Group> region = new osg::Group;
+    for (int cx = beginX; cx < endX; cx++) {
+        for (int cy = beginY; cy < endY; cy++) {
+            region->addChild(createChunkPage(cx, cy, options));
+        }
+    }
+    return region.release();
+}
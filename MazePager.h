@@ -0,0 +1,134 @@
+#pragma once
+
+#include <osg/Group>
+#include <osg/PagedLOD>
+#include <osgDB/FileNameUtils>
+#include <osgDB/Options>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "MazeGrid.h"
+#include "MazeMeshBuilder.h"
+#include "TextureRegistry.h"
+
+#define PAGED_REGION_CHUNKS 8 // Chunks along each side of a region, the leaves of the quadtree of pages
+#define PAGED_VIEW_DISTANCE 96.0f // Distance from the eye in cells within which chunks are kept loaded
+#define PAGED_MAX_RESIDENT 400 // Loaded pages the DatabasePager aims to stay below
+
+/**
+ * @class MazePager
+ * @brief Builds the maze scene as a quadtree of osg::PagedLOD tiles streamed by osgDB::DatabasePager.
+ *
+ * The leaves of the quadtree are regions of PAGED_REGION_CHUNKS x PAGED_REGION_CHUNKS chunks, and every
+ * region loads a group with one PagedLOD per chunk. Above them, a quad of level L covers 2^L x 2^L regions
+ * and loads a group with the pages of its four quarters, so the root holds at most four pages and culling
+ * stops at the first page out of range instead of visiting every region. All pages are file names handled
+ * by a pseudo-loader registered for the "mazequad", "mazeregion" and "mazechunk" extensions, which builds
+ * the nodes from the grid on the pager threads instead of reading files. Pages outside PAGED_VIEW_DISTANCE
+ * are expired by the pager, so the scene memory and the nodes visited per frame depend on the view distance
+ * and, through the depth of the tree, on the logarithm of the maze size; only the grid itself stays resident.
+ */
+class MazePager {
+public:
+    /**
+     * @brief Constructor for MazePager, creates the pages of the top quad without building any geometry.
+     *
+     * @param maze The shared maze grid.
+     * @param textures Registry providing the shared texture array StateSet.
+     * @param seed The seed of the texture choices.
+     */
+    MazePager(std::shared_ptr<const MazeGrid> maze, TextureRegistry& textures, uint64_t seed);
+
+    /**
+     * @brief Gets the root of the paged scene.
+     *
+     * @return osg::Group* - Group with the pages of the quarters of the whole maze.
+     */
+    osg::Group* getRoot() const;
+
+    /**
+     * @brief Prints the layout of the pages and the chunks built so far.
+     */
+    void printStats() const;
+
+    /**
+     * @class Source
+     * @brief Everything the pseudo-loader needs to build pages, passed along in the database options.
+     */
+    class Source : public osg::Referenced {
+    public:
+        Source(std::shared_ptr<const MazeGrid> maze, TextureRegistry& textures, uint64_t seed):
+            meshBuilder(maze, textures, seed),
+            regionsPerSide((meshBuilder.getChunksPerSide() + PAGED_REGION_CHUNKS - 1) / PAGED_REGION_CHUNKS) { }
+
+        MazeMeshBuilder meshBuilder; // Builds chunks on the pager threads
+        int regionsPerSide; // Number of regions along each side of the maze
+
+        /**
+         * @brief Creates the page of a single chunk.
+         *
+         * @param chunkX The x-index of the chunk.
+         * @param chunkY The y-index of the chunk.
+         * @param options Database options carrying this source.
+         * @return osg::PagedLOD* - Page loading the chunk when the eye comes within the view distance.
+         */
+        osg::PagedLOD* createChunkPage(int chunkX, int chunkY, osgDB::Options* options);
+
+        /**
+         * @brief Creates the page of a region.
+         *
+         * @param regionX The x-index of the region.
+         * @param regionY The y-index of the region.
+         * @param options Database options carrying this source.
+         * @return osg::PagedLOD* - Page loading the chunk pages of the region.
+         */
+        osg::PagedLOD* createRegionPage(int regionX, int regionY, osgDB::Options* options);
+
+        /**
+         * @brief Creates the page of a quad above the regions.
+         *
+         * @param level The level of the quad, it covers 2^level x 2^level regions.
+         * @param quadX The x-index of the quad among the quads of its level.
+         * @param quadY The y-index of the quad among the quads of its level.
+         * @param options Database options carrying this source.
+         * @return osg::PagedLOD* - Page loading the pages of the quarters of the quad.
+         */
+        osg::PagedLOD* createQuadPage(int level, int quadX, int quadY, osgDB::Options* options);
+
+        /**
+         * @brief Builds the group of pages of the quarters of a quad, called by the pseudo-loader.
+         *
+         * Quarters outside the maze are left out, the quarters of a level 1 quad are region pages.
+         *
+         * @param level The level of the quad, at least 1.
+         * @param quadX The x-index of the quad among the quads of its level.
+         * @param quadY The y-index of the quad among the quads of its level.
+         * @param options Database options carrying this source.
+         * @return osg::Group* - Group with up to four PagedLODs.
+         */
+        osg::Group* buildQuad(int level, int quadX, int quadY, osgDB::Options* options);
+
+        /**
+         * @brief Builds the group of chunk pages of a region, called by the pseudo-loader.
+         *
+         * @param regionX The x-index of the region.
+         * @param regionY The y-index of the region.
+         * @param options Database options carrying this source.
+         * @return osg::Group* - Group with one PagedLOD per chunk of the region.
+         */
+        osg::Group* buildRegion(int regionX, int regionY, osgDB::Options* options);
+    };
+
+protected:
+    osg::ref_ptr<Source> source; // Shared with the pager threads through the options
+    osg::ref_ptr<osgDB::Options> options; // Database options of every page
+    osg::ref_ptr<osg::Group> root; // Pages of the quarters of the top quad
+    int levels; // Level of the top quad, which covers the whole maze
+};
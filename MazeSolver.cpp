@@ -0,0 +1,196 @@
+#include "MazeSolver.h"
+
+namespace {
+
+const int dirX[] = {0, 0, 1, -1};
+const int dirY[] = {1, -1, 0, 0};
+const uint8_t UNVISITED = 0xFF;
+
+}
+
+MazeSolver::MazeSolver(std::shared_ptr<const MazeGrid> maze): maze(maze) { }
+
+std::vector<std::pair<int, int>> MazeSolver::findPath(int startX, int startY, int endX, int endY) const {
+    if (!isOpen(startX, startY) || !isOpen(endX, endY)) {
+        return std::vector<std::pair<int, int>>();
+    }
+
+    // Direction each cell was reached from, one byte per cell
+    int size = maze->getSize();
+    std::vector<uint8_t> from(static_cast<size_t>(size) * size, UNVISITED);
+    std::queue<size_t> queue; // Only holds the frontier, which stays small in corridors
+    size_t start = static_cast<size_t>(startX) * size + startY;
+    size_t target = static_cast<size_t>(endX) * size + endY;
+    queue.push(start);
+    from[start] = 4;
+
+    while (!queue.empty() && from[target] == UNVISITED) {
+        int x = static_cast<int>(queue.front() / size), y = static_cast<int>(queue.front() % size);
+        queue.pop();
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dirX[d], ny = y + dirY[d];
+            if (isOpen(nx, ny) && from[static_cast<size_t>(nx) * size + ny] == UNVISITED) {
+                from[static_cast<size_t>(nx) * size + ny] = static_cast<uint8_t>(d);
+                queue.push(static_cast<size_t>(nx) * size + ny);
+            }
+        }
+    }
+
+    if (from[target] == UNVISITED) {
+        return std::vector<std::pair<int, int>>();
+    }
+    return tracePath(from, endX, endY);
+}
+
+std::vector<std::pair<int, int>> MazeSolver::findPathAStar(int startX, int startY, int endX, int endY) const {
+    if (!isOpen(startX, startY) || !isOpen(endX, endY)) {
+        return std::vector<std::pair<int, int>>();
+    }
+
+    // Open list entry, the direction is recorded when the cell is closed so duplicates stay cheap
+    struct Node {
+        uint32_t f; // Cost so far plus the Manhattan distance to the end
+        uint32_t g; // Cost so far
+        size_t cell; // Cell index
+        uint8_t direction; // Direction the cell was reached from
+        bool operator>(const Node& other) const {
+            // Among equal estimates expand the deepest node first, it is closest to the end
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+    auto heuristic = [&](int x, int y) {
+        return static_cast<uint32_t>(std::abs(x - endX) + std::abs(y - endY));
+    };
+
+    int size = maze->getSize();
+    std::vector<uint8_t> from(static_cast<size_t>(size) * size, UNVISITED);
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+    size_t target = static_cast<size_t>(endX) * size + endY;
+    open.push(Node{heuristic(startX, startY), 0, static_cast<size_t>(startX) * size + startY, 4});
+
+    while (!open.empty()) {
+        Node node = open.top();
+        open.pop();
+        if (from[node.cell] != UNVISITED) {
+            continue; // Closed through a shorter route already
+        }
+        from[node.cell] = node.direction;
+        if (node.cell == target) {
+            return tracePath(from, endX, endY);
+        }
+
+        int x = static_cast<int>(node.cell / size), y = static_cast<int>(node.cell % size);
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dirX[d], ny = y + dirY[d];
+            if (isOpen(nx, ny) && from[static_cast<size_t>(nx) * size + ny] == UNVISITED) {
+                open.push(Node{node.g + 1 + heuristic(nx, ny), node.g + 1, static_cast<size_t>(nx) * size + ny, static_cast<uint8_t>(d)});
+            }
+        }
+    }
+
+    return std::vector<std::pair<int, int>>();
+}
+
+int MazeSolver::getDistanceBitParallel(int startX, int startY, int endX, int endY) const {
+    if (!isOpen(startX, startY) || !isOpen(endX, endY)) {
+        return -1;
+    }
+    if (startX == endX && startY == endY) {
+        return 0;
+    }
+
+    int size = maze->getSize();
+    size_t maskWords = (static_cast<size_t>(size) + 63) / 64;
+    std::vector<uint64_t> open = buildOpenMask(maskWords);
+    std::vector<uint64_t> visited(open.size(), 0), frontier(open.size(), 0), next(open.size(), 0);
+    std::vector<size_t> active, nextActive; // Words holding frontier cells
+
+    size_t startWord = static_cast<size_t>(startX) * maskWords + startY / 64;
+    size_t targetWord = static_cast<size_t>(endX) * maskWords + endY / 64;
+    uint64_t targetBit = uint64_t(1) << (endY % 64);
+    frontier[startWord] = visited[startWord] = uint64_t(1) << (startY % 64);
+    active.push_back(startWord);
+
+    // Adds the cells of a word to the next layer, keeping only open cells seen for the first time
+    auto spread = [&](size_t word, uint64_t bits) {
+        bits &= open[word] & ~visited[word];
+        if (bits) {
+            if (!next[word]) {
+                nextActive.push_back(word);
+            }
+            next[word] |= bits;
+            visited[word] |= bits;
+        }
+    };
+
+    for (int distance = 1; !active.empty(); distance++) {
+        nextActive.clear();
+        for (size_t word : active) {
+            uint64_t bits = frontier[word];
+            frontier[word] = 0;
+            size_t column = word % maskWords;
+
+            // Neighbours along the row are a shift away, the edge bits carry over into the adjacent words
+            spread(word, (bits << 1) | (bits >> 1));
+            if (column > 0) spread(word - 1, bits << 63);
+            if (column + 1 < maskWords) spread(word + 1, bits >> 63);
+            if (word >= maskWords) spread(word - maskWords, bits);
+            if (word + maskWords < open.size()) spread(word + maskWords, bits);
+        }
+        if (next[targetWord] & targetBit) {
+            return distance;
+        }
+        std::swap(frontier, next);
+        std::swap(active, nextActive);
+    }
+
+    return -1;
+}
+
+std::vector<std::pair<int, int>> MazeSolver::tracePath(const std::vector<uint8_t>& from, int endX, int endY) const {
+    std::vector<std::pair<int, int>> path;
+    int size = maze->getSize();
+    int x = endX, y = endY;
+    while (true) {
+        path.push_back(std::make_pair(x, y));
+        uint8_t d = from[static_cast<size_t>(x) * size + y];
+        if (d == 4) {
+            break;
+        }
+        x -= dirX[d];
+        y -= dirY[d];
+    }
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+std::vector<uint64_t> MazeSolver::buildOpenMask(size_t maskWords) const {
+    int size = maze->getSize();
+    size_t rowWords = maze->getRowWords();
+    std::vector<uint64_t> open(static_cast<size_t>(size) * maskWords, 0);
+
+    for (int x = 0; x < size; x++) {
+        const uint64_t* row = maze->getRow(x);
+        uint64_t* mask = &open[static_cast<size_t>(x) * maskWords];
+        for (size_t w = 0; w < rowWords; w++) {
+            // A cell is a wall when its low bit is set and its high bit is clear
+            uint64_t cells = ~(row[w] & ~(row[w] >> 1)) & 0x5555555555555555ULL;
+
+            // Pack the even bits into the low 32 bits
+            cells = (cells | (cells >> 1)) & 0x3333333333333333ULL;
+            cells = (cells | (cells >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+            cells = (cells | (cells >> 4)) & 0x00FF00FF00FF00FFULL;
+            cells = (cells | (cells >> 8)) & 0x0000FFFF0000FFFFULL;
+            cells = (cells | (cells >> 16)) & 0x00000000FFFFFFFFULL;
+            mask[w / 2] |= cells << (32 * (w % 2));
+        }
+
+        // Padding after the last cell reads as PATH, it must not be walkable
+        if (size % 64) {
+            mask[maskWords - 1] &= (uint64_t(1) << (size % 64)) - 1;
+        }
+    }
+
+    return open;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "MazeGrid.h"
+
+/**
+ * @class MazeSolver
+ * @brief Finds routes through a maze grid.
+ *
+ * Every cell that is not a WALL can be walked on, including START and END.
+ * The path searches keep one byte per cell for the direction a cell was reached from, the bit-parallel
+ * search keeps two bits per cell and expands the frontier 64 cells at a time.
+ */
+class MazeSolver {
+public:
+    /**
+     * @brief Constructor for MazeSolver.
+     *
+     * @param maze The shared maze grid.
+     */
+    MazeSolver(std::shared_ptr<const MazeGrid> maze);
+
+    /**
+     * @brief Finds a shortest path between two cells with a breadth-first search.
+     *
+     * @param startX The x-coordinate of the first cell.
+     * @param startY The y-coordinate of the first cell.
+     * @param endX The x-coordinate of the last cell.
+     * @param endY The y-coordinate of the last cell.
+     * @return std::vector<std::pair<int, int>> - Cells of the path including both ends, empty if there is none.
+     */
+    std::vector<std::pair<int, int>> findPath(int startX, int startY, int endX, int endY) const;
+
+    /**
+     * @brief Finds a shortest path between two cells with an A* search guided by the Manhattan distance.
+     *
+     * @param startX The x-coordinate of the first cell.
+     * @param startY The y-coordinate of the first cell.
+     * @param endX The x-coordinate of the last cell.
+     * @param endY The y-coordinate of the last cell.
+     * @return std::vector<std::pair<int, int>> - Cells of the path including both ends, empty if there is none.
+     */
+    std::vector<std::pair<int, int>> findPathAStar(int startX, int startY, int endX, int endY) const;
+
+    /**
+     * @brief Gets the length of a shortest path with a bit-parallel breadth-first search.
+     *
+     * Open cells and visited cells are kept as bit masks with one bit per cell, and every layer is expanded
+     * by shifting whole 64-bit words of the frontier, so a word of frontier costs a handful of instructions
+     * no matter how many of its cells are set. Only words holding frontier cells are touched.
+     *
+     * @param startX The x-coordinate of the first cell.
+     * @param startY The y-coordinate of the first cell.
+     * @param endX The x-coordinate of the last cell.
+     * @param endY The y-coordinate of the last cell.
+     * @return int - Number of steps between the cells, -1 if the end cannot be reached.
+     */
+    int getDistanceBitParallel(int startX, int startY, int endX, int endY) const;
+
+protected:
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+
+    /**
+     * @brief Walks the search directions back from the end to the start.
+     *
+     * @param from Direction each cell was reached from, 4 for the start cell.
+     * @param endX The x-coordinate of the last cell.
+     * @param endY The y-coordinate of the last cell.
+     * @return std::vector<std::pair<int, int>> - Cells of the path including both ends.
+     */
+    std::vector<std::pair<int, int>> tracePath(const std::vector<uint8_t>& from, int endX, int endY) const;
+
+    /**
+     * @brief Builds the mask of open cells, one bit per cell and each row padded to whole words.
+     *
+     * @param maskWords Number of 64-bit words per row of the mask.
+     * @return std::vector<uint64_t> - The mask, bit y % 64 of word y / 64 of a row is set if the cell is open.
+     */
+    std::vector<uint64_t> buildOpenMask(size_t maskWords) const;
+
+    /**
+     * @brief Checks if the specified cell can be walked on.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return bool - True if the cell is inside the maze and not a wall.
+     */
+    bool isOpen(int x, int y) const { return maze->contains(x, y) && maze->get(x, y) != WALL; }
+};
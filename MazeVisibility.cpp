@@ -0,0 +1,164 @@
+#include "MazeVisibility.h"
+
+MazeVisibility::MazeVisibility(std::shared_ptr<const MazeGrid> maze):
+    maze(maze),
+    chunksPerSide((maze->getSize() + CHUNK_SIZE - 1) / CHUNK_SIZE),
+    visibleChunks(static_cast<size_t>(chunksPerSide) * chunksPerSide),
+    computeTime(0.0)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Ray directions shared by all cells, the axis-aligned ones get exact zero components
+    for (int r = 0; r < VISIBILITY_RAYS; r++) {
+        double angle = 2.0 * M_PI * r / VISIBILITY_RAYS;
+        rayDirX[r] = std::fabs(std::cos(angle)) < 1e-9 ? 0.0 : std::cos(angle);
+        rayDirY[r] = std::fabs(std::sin(angle)) < 1e-9 ? 0.0 : std::sin(angle);
+    }
+
+    // Every chunk writes only its own set, so the chunks are shared out between threads
+    int totalChunks = chunksPerSide * chunksPerSide;
+    int threadCount = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), totalChunks));
+    std::atomic<int> nextChunk(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([this, &nextChunk, totalChunks]() {
+            std::vector<int> chunks;
+            for (int chunk = nextChunk++; chunk < totalChunks; chunk = nextChunk++) {
+                computeChunk(chunk / chunksPerSide, chunk % chunksPerSide, chunks);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    computeTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+void MazeVisibility::computeChunk(int cx, int cy, std::vector<int>& chunks) {
+    // The camera moves over the whole cell, so rays also start next to its corners
+    const double originX[5] = {0.0, -VISIBILITY_EDGE_OFFSET, -VISIBILITY_EDGE_OFFSET, VISIBILITY_EDGE_OFFSET, VISIBILITY_EDGE_OFFSET};
+    const double originY[5] = {0.0, -VISIBILITY_EDGE_OFFSET, VISIBILITY_EDGE_OFFSET, -VISIBILITY_EDGE_OFFSET, VISIBILITY_EDGE_OFFSET};
+
+    int size = maze->getSize();
+    chunks.clear();
+    for (int i = cx * CHUNK_SIZE; i < std::min((cx + 1) * CHUNK_SIZE, size); i++) {
+        for (int j = cy * CHUNK_SIZE; j < std::min((cy + 1) * CHUNK_SIZE, size); j++) {
+            if (isSolid(i, j)) {
+                continue;
+            }
+            if (chunks.empty()) {
+                chunks.push_back(getChunkIndex(i, j));
+            }
+            for (int o = 0; o < 5; o++) {
+                for (int r = 0; r < VISIBILITY_RAYS; r++) {
+                    castRay(i, j, originX[o], originY[o], rayDirX[r], rayDirY[r], chunks);
+                }
+            }
+        }
+    }
+    if (chunks.empty()) {
+        return; // No open cells, the camera can never be here
+    }
+
+    std::sort(chunks.begin(), chunks.end());
+    chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+
+    // Grow the set by the surrounding ring of chunks
+    std::vector<int>& visible = visibleChunks[static_cast<size_t>(cx) * chunksPerSide + cy];
+    for (int chunk : chunks) {
+        int x = chunk / chunksPerSide, y = chunk % chunksPerSide;
+        for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, chunksPerSide - 1); nx++) {
+            for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, chunksPerSide - 1); ny++) {
+                visible.push_back(nx * chunksPerSide + ny);
+            }
+        }
+    }
+    std::sort(visible.begin(), visible.end());
+    visible.erase(std::unique(visible.begin(), visible.end()), visible.end());
+    visible.shrink_to_fit();
+}
+
+const std::vector<int>& MazeVisibility::getVisibleChunks(int chunk) const {
+    return visibleChunks[chunk];
+}
+
+int MazeVisibility::getChunkIndex(int x, int y) const {
+    if (!maze->contains(x, y)) {
+        return -1;
+    }
+    return (x / CHUNK_SIZE) * chunksPerSide + y / CHUNK_SIZE;
+}
+
+void MazeVisibility::printStats() const {
+    size_t total = 0, populated = 0;
+    for (const std::vector<int>& visible : visibleChunks) {
+        total += visible.size();
+        populated += visible.empty() ? 0 : 1;
+    }
+    std::cout << "VISIBILITY: " << visibleChunks.size() << " chunks, "
+              << (populated ? static_cast<double>(total) / populated : 0.0) << " visible on average, computed in "
+              << computeTime << " ms" << std::endl;
+}
+
+bool MazeVisibility::isSolid(int x, int y) const {
+    if (!maze->contains(x, y)) {
+        return true;
+    }
+    CellType cell = maze->get(x, y);
+    return cell == WALL || cell == END;
+}
+
+void MazeVisibility::castRay(int x, int y, double originX, double originY, double dirX, double dirY, std::vector<int>& chunks) const {
+    // Grid traversal from the origin, cell (x, y) spans [x-0.5, x+0.5] x [y-0.5, y+0.5]
+    int stepX = dirX > 0.0 ? 1 : -1;
+    int stepY = dirY > 0.0 ? 1 : -1;
+    double deltaX = dirX != 0.0 ? std::fabs(1.0 / dirX) : INFINITY;
+    double deltaY = dirY != 0.0 ? std::fabs(1.0 / dirY) : INFINITY;
+    double maxX = dirX != 0.0 ? (0.5 - stepX * originX) * deltaX : INFINITY;
+    double maxY = dirY != 0.0 ? (0.5 - stepY * originY) * deltaY : INFINITY;
+
+    // The chunk of the start cell is recorded once by the caller
+    int lastChunk = getChunkIndex(x, y);
+    while (true) {
+        if (maxX < maxY) {
+            x += stepX;
+            maxX += deltaX;
+        } else {
+            y += stepY;
+            maxY += deltaY;
+        }
+
+        int chunk = getChunkIndex(x, y);
+        if (chunk < 0) {
+            return;
+        }
+        if (chunk != lastChunk) {
+            chunks.push_back(chunk);
+            lastChunk = chunk;
+        }
+        if (isSolid(x, y)) {
+            return; // The face of this cell is the last thing seen along the ray
+        }
+    }
+}
+
+VisibilityCullCallback::VisibilityCullCallback(std::shared_ptr<const MazeVisibility> visibility): visibility(visibility) { }
+
+void VisibilityCullCallback::operator()(osg::Node* node, osg::NodeVisitor* nv) {
+    osg::Group* group = node->asGroup();
+    osg::Vec3 eye = nv->getEyePoint();
+    int chunk = visibility->getChunkIndex(static_cast<int>(std::round(eye.x())), static_cast<int>(std::round(eye.y())));
+
+    if (!group || chunk < 0 || eye.z() > VISIBILITY_MAX_EYE_Z || visibility->getVisibleChunks(chunk).empty()) {
+        traverse(node, nv); // Outside the maze or above the walls
+        return;
+    }
+
+    for (int visible : visibility->getVisibleChunks(chunk)) {
+        if (static_cast<unsigned>(visible) < group->getNumChildren()) {
+            group->getChild(visible)->accept(*nv);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <osg/NodeCallback>
+#include <osg/NodeVisitor>
+#include <osg/Group>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MazeGrid.h"
+#include "MazeMeshBuilder.h"
+
+#define VISIBILITY_RAYS 32 // Number of rays cast from every ray origin, the first one along +x
+#define VISIBILITY_EDGE_OFFSET 0.49 // Distance of the corner ray origins from the cell center along each axis
+#define VISIBILITY_MAX_EYE_Z 1.0 // Above the walls everything may be visible
+
+/**
+ * @class MazeVisibility
+ * @brief Potentially visible set of mesh chunks for every chunk of the maze.
+ *
+ * For each open cell VISIBILITY_RAYS rays are marched through the grid from its center and from just
+ * inside its four corners until they hit a solid cell, and every chunk they touch is recorded for the
+ * chunk of the cell. Four of the rays run exactly along the axes, so straight corridors are seen to their
+ * end whatever their length. Each set is then grown by the ring of neighbouring chunks, which covers
+ * the gaps between rays. The chunks are computed in parallel on all cores.
+ */
+class MazeVisibility {
+public:
+    /**
+     * @brief Constructor for MazeVisibility, computes the visible sets.
+     *
+     * @param maze The shared maze grid.
+     */
+    MazeVisibility(std::shared_ptr<const MazeGrid> maze);
+
+    /**
+     * @brief Gets the chunks potentially visible from the specified chunk.
+     *
+     * @param chunk The chunk index as used by MazeMeshBuilder.
+     * @return const std::vector<int>& - Sorted chunk indices, empty if the chunk has no open cells.
+     */
+    const std::vector<int>& getVisibleChunks(int chunk) const;
+
+    /**
+     * @brief Gets the index of the chunk containing the specified cell.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return int - The chunk index, or -1 if the cell lies outside the maze.
+     */
+    int getChunkIndex(int x, int y) const;
+
+    /**
+     * @brief Prints the size of the visible sets and the time it took to compute them.
+     */
+    void printStats() const;
+
+protected:
+    std::shared_ptr<const MazeGrid> maze; // Shared grid representing the maze
+    int chunksPerSide; // Number of chunks along each side of the maze
+    std::vector<std::vector<int>> visibleChunks; // Visible chunk indices by chunk index
+    double computeTime; // Time spent computing the sets in milliseconds
+    double rayDirX[VISIBILITY_RAYS]; // x-components of the ray directions
+    double rayDirY[VISIBILITY_RAYS]; // y-components of the ray directions
+
+    /**
+     * @brief Casts the rays of every open cell of a chunk and stores the grown visible set of the chunk.
+     *
+     * @param cx The x-index of the chunk.
+     * @param cy The y-index of the chunk.
+     * @param chunks Scratch buffer for the chunks hit by the rays.
+     */
+    void computeChunk(int cx, int cy, std::vector<int>& chunks);
+
+    /**
+     * @brief Checks if the specified cell blocks the view.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return bool - True for walls, the finishing block and cells outside the maze.
+     */
+    bool isSolid(int x, int y) const;
+
+    /**
+     * @brief Marches a ray through the grid and records the chunks it passes.
+     *
+     * @param x The x-coordinate of the cell the ray starts in.
+     * @param y The y-coordinate of the cell the ray starts in.
+     * @param originX The x-offset of the ray origin from the cell center, between -0.5 and 0.5.
+     * @param originY The y-offset of the ray origin from the cell center, between -0.5 and 0.5.
+     * @param dirX The x-component of the ray direction.
+     * @param dirY The y-component of the ray direction.
+     * @param chunks Chunk indices the ray passes are appended here.
+     */
+    void castRay(int x, int y, double originX, double originY, double dirX, double dirY, std::vector<int>& chunks) const;
+};
+
+/**
+ * @class VisibilityCullCallback
+ * @brief Cull callback for the chunk group built by MazeMeshBuilder that traverses only the visible chunks.
+ *
+ * When the eye is outside the maze or above the walls, all chunks are traversed.
+ */
+class VisibilityCullCallback : public osg::NodeCallback {
+public:
+    /**
+     * @brief Constructor for VisibilityCullCallback.
+     *
+     * @param visibility The precomputed visible sets.
+     */
+    VisibilityCullCallback(std::shared_ptr<const MazeVisibility> visibility);
+
+    /**
+     * @brief Traverses the chunks potentially visible from the eye point.
+     *
+     * @param node The chunk group.
+     * @param nv The cull visitor.
+     */
+    virtual void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+protected:
+    std::shared_ptr<const MazeVisibility> visibility; // The precomputed visible sets
+};
@@ -0,0 +1,141 @@
+#include "ParallelMazeGenerator.h"
+
+ParallelMazeGenerator::ParallelMazeGenerator(int size, uint64_t seed, unsigned threads):
+    size(size),
+    seed(seed),
+    tilesPerSide((size - 3) / TILE_SIZE + 1),
+    maze(std::make_shared<MazeGrid>(size, WALL))
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Workers pull tiles from a shared counter, the order does not affect the result
+    std::atomic<int> nextTile(0);
+    int tiles = tilesPerSide * tilesPerSide;
+    auto worker = [&]() {
+        std::vector<int> stack;
+        for (int tile = nextTile++; tile < tiles; tile = nextTile++) {
+            carveTile(tile, stack);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+
+    joinTiles();
+    maze->set(1, 1, START);
+    maze->set(size-1, size-2, END);
+}
+
+std::shared_ptr<const MazeGrid> ParallelMazeGenerator::getMaze() const {
+    return maze;
+}
+
+bool ParallelMazeGenerator::saveMaze(const std::string& path) const {
+    MazeFileInfo info;
+    info.size = size;
+    info.startX = 1;
+    info.startY = 1;
+    info.endX = size-1;
+    info.endY = size-2;
+    info.seed = seed;
+    info.algorithm = ALGORITHM_PARALLEL_DFS;
+    return saveMazeFile(path, *maze, info);
+}
+
+void ParallelMazeGenerator::carveTile(int tile, std::vector<int>& stack) {
+    // Cells of the tile lie on odd coordinates, the wall line on its low edge belongs to it
+    int x0 = (tile / tilesPerSide) * TILE_SIZE;
+    int y0 = (tile % tilesPerSide) * TILE_SIZE;
+    int cellsX = (std::min(x0 + TILE_SIZE, size - 1) - x0) / 2;
+    int cellsY = (std::min(y0 + TILE_SIZE, size - 1) - y0) / 2;
+
+    const int dirX[] = {0, 0, 1, -1};
+    const int dirY[] = {1, -1, 0, 0};
+
+    Random rng(mixSeed(seed, static_cast<uint64_t>(tile) + 1));
+    stack.clear();
+    stack.push_back(0);
+    maze->set(x0 + 1, y0 + 1, PATH);
+
+    while (!stack.empty()) {
+        int i = stack.back() / cellsY, j = stack.back() % cellsY;
+
+        // Pick a random unvisited neighbour, backtrack if there is none
+        int options[4], count = 0;
+        for (int d = 0; d < 4; d++) {
+            int ni = i + dirX[d], nj = j + dirY[d];
+            if (ni >= 0 && ni < cellsX && nj >= 0 && nj < cellsY && maze->get(x0 + 1 + 2 * ni, y0 + 1 + 2 * nj) == WALL) {
+                options[count++] = d;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int d = options[rng.nextBelow(count)];
+        int ni = i + dirX[d], nj = j + dirY[d];
+        maze->set(x0 + 1 + 2 * i + dirX[d], y0 + 1 + 2 * j + dirY[d], PATH);
+        maze->set(x0 + 1 + 2 * ni, y0 + 1 + 2 * nj, PATH);
+        stack.push_back(ni * cellsY + nj);
+    }
+}
+
+void ParallelMazeGenerator::joinTiles() {
+    // Edges between neighbouring tiles, encoded as tile * 2 + (0 = next along y, 1 = next along x)
+    std::vector<int> edges;
+    for (int tx = 0; tx < tilesPerSide; tx++) {
+        for (int ty = 0; ty < tilesPerSide; ty++) {
+            int tile = tx * tilesPerSide + ty;
+            if (ty + 1 < tilesPerSide) edges.push_back(tile * 2);
+            if (tx + 1 < tilesPerSide) edges.push_back(tile * 2 + 1);
+        }
+    }
+
+    // Fisher-Yates shuffle written out, std::shuffle differs between standard libraries
+    Random rng(mixSeed(seed, 0));
+    for (size_t i = edges.size(); i > 1; i--) {
+        std::swap(edges[i - 1], edges[rng.nextBelow(static_cast<uint32_t>(i))]);
+    }
+
+    // Kruskal over the shuffled edges gives a random spanning tree of the tiles
+    std::vector<int> parent(static_cast<size_t>(tilesPerSide) * tilesPerSide);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int tile) {
+        while (parent[tile] != tile) {
+            parent[tile] = parent[parent[tile]];
+            tile = parent[tile];
+        }
+        return tile;
+    };
+
+    for (int edge : edges) {
+        int tile = edge / 2;
+        bool alongX = edge % 2;
+        int other = alongX ? tile + tilesPerSide : tile + 1;
+        int a = find(tile), b = find(other);
+        if (a == b) {
+            continue;
+        }
+        parent[b] = a;
+
+        // Open one wall on the shared border, next to a random cell of the tile
+        int x0 = (tile / tilesPerSide) * TILE_SIZE;
+        int y0 = (tile % tilesPerSide) * TILE_SIZE;
+        if (alongX) {
+            int cellsY = (std::min(y0 + TILE_SIZE, size - 1) - y0) / 2;
+            maze->set(x0 + TILE_SIZE, y0 + 1 + 2 * static_cast<int>(rng.nextBelow(cellsY)), PATH);
+        } else {
+            int cellsX = (std::min(x0 + TILE_SIZE, size - 1) - x0) / 2;
+            maze->set(x0 + 1 + 2 * static_cast<int>(rng.nextBelow(cellsX)), y0 + TILE_SIZE, PATH);
+        }
+    }
+}
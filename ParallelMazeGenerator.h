@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "MazeGrid.h"
+#include "MazeFile.h"
+#include "Random.h"
+
+#define TILE_SIZE 256 // Grid cells along each side of a tile, a multiple of 2*MazeGrid::CELLS_PER_WORD
+
+/**
+ * @class ParallelMazeGenerator
+ * @brief Generates a perfect maze on all cores by carving independent tiles and joining them.
+ *
+ * The grid is split into TILE_SIZE x TILE_SIZE tiles. Each tile is carved with a randomized depth-first search
+ * driven by its own RNG seeded from the maze seed and the tile index, and the tiles are then connected along
+ * a random spanning tree of the tile graph, opening one wall per tree edge. Trees joined by a tree stay a tree,
+ * so the maze is perfect, and since no random choice depends on scheduling the result for a given seed
+ * is identical for any number of threads.
+ * Tile borders fall on 64-bit word boundaries of MazeGrid rows, so threads never write to the same word.
+ */
+class ParallelMazeGenerator {
+public:
+    /**
+     * @brief Constructor for ParallelMazeGenerator, generates the maze.
+     *
+     * @param size The size (width and height) of the maze, must be odd.
+     * @param seed The seed all random choices are derived from.
+     * @param threads Number of worker threads, 0 to use all hardware threads.
+     */
+    ParallelMazeGenerator(int size, uint64_t seed, unsigned threads = 0);
+
+    /**
+     * @brief Gets the generated maze.
+     *
+     * @return std::shared_ptr<const MazeGrid> - The maze grid with START at (1, 1) and END at (size-1, size-2).
+     */
+    std::shared_ptr<const MazeGrid> getMaze() const;
+
+    /**
+     * @brief Saves the generated maze to a binary maze file.
+     *
+     * @param path Path of the file to write.
+     * @return bool - True if the file was written, false otherwise.
+     */
+    bool saveMaze(const std::string& path) const;
+
+protected:
+    int size; // The size (width and height) of the maze
+    uint64_t seed; // The seed all random choices are derived from
+    int tilesPerSide; // Number of tiles along each side of the maze
+    std::shared_ptr<MazeGrid> maze; // The maze represented with CellType values
+
+    /**
+     * @brief Carves a perfect maze inside a single tile.
+     *
+     * @param tile The tile index.
+     * @param stack Reusable DFS stack of the calling thread.
+     */
+    void carveTile(int tile, std::vector<int>& stack);
+
+    /**
+     * @brief Connects the tiles along a random spanning tree.
+     */
+    void joinTiles();
+};
@@ -0,0 +1,55 @@
+#include "Random.h"
+
+#include <cmath>
+
+uint64_t mixSeed(uint64_t seed, uint64_t stream) {
+    // SplitMix64 finalizer
+    uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Random::Random(uint64_t seed) {
+    for (uint64_t i = 0; i < 4; i++) {
+        state[i] = mixSeed(seed, i);
+    }
+}
+
+AliasTable::AliasTable(const std::vector<int>& weights): probability(weights.size()), alias(weights.size()) {
+    long long total = 0;
+    for (int weight : weights) {
+        total += weight;
+    }
+
+    // Scale every weight so that the average column is exactly full, in integers so no weight is lost to rounding
+    long long n = static_cast<long long>(weights.size());
+    std::vector<long long> scaled(weights.size());
+    std::vector<int> small, large;
+    for (size_t i = 0; i < weights.size(); i++) {
+        scaled[i] = weights[i] * n;
+        alias[i] = static_cast<int>(i);
+        (scaled[i] < total ? small : large).push_back(static_cast<int>(i));
+    }
+
+    // Fill every column below the average with the excess of a column above it
+    while (!small.empty() && !large.empty()) {
+        int less = small.back(), more = large.back();
+        small.pop_back();
+        probability[less] = static_cast<uint64_t>(std::ldexp(static_cast<double>(scaled[less]) / static_cast<double>(total), 32));
+        alias[less] = more;
+        scaled[more] -= total - scaled[less];
+        if (scaled[more] < total) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Whatever is left is exactly full
+    for (int i : large) {
+        probability[i] = 1ULL << 32;
+    }
+    for (int i : small) {
+        probability[i] = 1ULL << 32;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Derives a well-mixed 64-bit value from a seed and a stream index.
+ *
+ * Used to give every generator, tile or chunk its own independent random stream.
+ *
+ * @param seed The base seed.
+ * @param stream Index of the random stream.
+ * @return uint64_t - The derived seed.
+ */
+uint64_t mixSeed(uint64_t seed, uint64_t stream);
+
+/**
+ * @class Random
+ * @brief Seedable xoshiro256** generator owned by a single generator or thread.
+ *
+ * Replaces the global rand(): every instance has its own state, so results do not depend on how
+ * threads are scheduled, and the sequence for a seed is the same with every compiler and standard library.
+ */
+class Random {
+public:
+    /**
+     * @brief Constructor for Random, expands the seed into the 256-bit state with SplitMix64.
+     *
+     * @param seed The seed.
+     */
+    Random(uint64_t seed = 0);
+
+    /**
+     * @brief Gets the next 64 random bits.
+     *
+     * @return uint64_t - Uniformly distributed value.
+     */
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Gets a random integer below the bound using Lemire's multiply-shift.
+     *
+     * The tiny bias for bounds that are not powers of two is far below anything the maze can show.
+     *
+     * @param bound Exclusive upper bound, must be positive.
+     * @return uint32_t - Value in [0, bound).
+     */
+    uint32_t nextBelow(uint32_t bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    /**
+     * @brief Gets a random double in [0, 1) from the top 53 bits.
+     *
+     * @return double - Uniformly distributed value.
+     */
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+protected:
+    uint64_t state[4]; // Generator state, never all zero
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+/**
+ * @class AliasTable
+ * @brief Samples an index with probability proportional to its weight in constant time (Vose's alias method).
+ *
+ * Building the table is O(n); every sample costs one random number, one table lookup and one comparison,
+ * regardless of the number of weights.
+ */
+class AliasTable {
+public:
+    /**
+     * @brief Constructor for AliasTable.
+     *
+     * @param weights Non-negative weights, at least one of them positive.
+     */
+    AliasTable(const std::vector<int>& weights);
+
+    /**
+     * @brief Draws a random index.
+     *
+     * @param rng The generator to draw from.
+     * @return int - Index into the weights given to the constructor.
+     */
+    int sample(Random& rng) const {
+        uint64_t bits = rng.next();
+        uint32_t column = static_cast<uint32_t>(((bits >> 32) * probability.size()) >> 32);
+        return static_cast<uint32_t>(bits) < probability[column] ? static_cast<int>(column) : alias[column];
+    }
+
+    /**
+     * @brief Gets the number of weights in the table.
+     *
+     * @return size_t - The number of weights.
+     */
+    size_t size() const { return probability.size(); }
+
+protected:
+    std::vector<uint64_t> probability; // Threshold of every column scaled to 2^32, kept wide so 2^32 is representable
+    std::vector<int> alias; // Index taking the rest of every column
+};
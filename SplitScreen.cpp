@@ -0,0 +1,85 @@
+#include "SplitScreen.h"
+#include "FrameBenchmark.h"
+
+void KeyBroadcastHandler::addController(CameraController* controller) {
+    controllers.push_back(controller);
+}
+
+bool KeyBroadcastHandler::handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa) {
+    if (ea.getEventType() != osgGA::GUIEventAdapter::KEYDOWN && ea.getEventType() != osgGA::GUIEventAdapter::KEYUP) {
+        return false;
+    }
+
+    // The controller of the focused view gets the event from its own view
+    for (osg::ref_ptr<CameraController>& controller : controllers) {
+        if (controller->getView() != aa.asView()) {
+            controller->handleKey(ea);
+        }
+    }
+    return false;
+}
+
+SplitScreen::SplitScreen(int count):
+    viewer(new osgViewer::CompositeViewer),
+    broadcaster(new KeyBroadcastHandler)
+{
+    for (int i = 0; i < count; i++) {
+        osg::ref_ptr<osgViewer::View> view = new osgViewer::View;
+        view->addEventHandler(broadcaster.get());
+        views.push_back(view);
+        viewer->addView(view.get());
+    }
+}
+
+bool SplitScreen::setUp(osg::Node* scene, int x, int y, int width, int height, bool offscreen) {
+    osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+    traits->x = x;
+    traits->y = y;
+    traits->width = width;
+    traits->height = height;
+    traits->windowDecoration = !offscreen;
+    traits->doubleBuffer = !offscreen;
+    traits->pbuffer = offscreen;
+
+    osg::ref_ptr<osg::GraphicsContext> context = osg::GraphicsContext::createGraphicsContext(traits.get());
+    if (!context.valid()) {
+        std::cerr << "Cannot create a graphics context for " << views.size() << " views" << std::endl;
+        return false;
+    }
+
+    // Tile the window row by row from the top left, as square as the number of views allows
+    int count = static_cast<int>(views.size());
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    int rows = (count + columns - 1) / columns;
+    int tileWidth = width / columns, tileHeight = height / rows;
+    GLenum buffer = offscreen ? GL_FRONT : GL_BACK;
+    for (int i = 0; i < count; i++) {
+        osg::Camera* camera = views[i]->getCamera();
+        camera->setGraphicsContext(context.get());
+        camera->setViewport(new osg::Viewport((i % columns) * tileWidth, (rows - 1 - i / columns) * tileHeight, tileWidth, tileHeight));
+        camera->setProjectionMatrixAsPerspective(SPLIT_SCREEN_FOV, static_cast<double>(tileWidth) / tileHeight,
+                                                 SPLIT_SCREEN_NEAR, SPLIT_SCREEN_FAR);
+        camera->setDrawBuffer(buffer);
+        camera->setReadBuffer(buffer);
+        FrameBenchmark::enableTraversalStats(camera);
+        views[i]->setSceneData(scene);
+    }
+    return true;
+}
+
+void SplitScreen::setController(int index, CameraController* controller) {
+    views[index]->setCameraManipulator(controller);
+    broadcaster->addController(controller);
+}
+
+osgViewer::CompositeViewer& SplitScreen::getViewer() {
+    return *viewer;
+}
+
+osgViewer::View* SplitScreen::getView(int index) const {
+    return views[index].get();
+}
+
+int SplitScreen::getNumViews() const {
+    return static_cast<int>(views.size());
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <osg/GraphicsContext>
+#include <osg/Viewport>
+#include <osgGA/GUIEventHandler>
+#include <osgViewer/CompositeViewer>
+#include <osgViewer/View>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "CameraController.h"
+
+#define SPLIT_SCREEN_FOV 30.0 // Vertical field of view of every view in degrees
+#define SPLIT_SCREEN_NEAR 0.1 // Near plane of every view
+#define SPLIT_SCREEN_FAR 1000.0 // Far plane of every view
+
+/**
+ * @class KeyBroadcastHandler
+ * @brief Passes key events to the controllers of the views without the focus.
+ *
+ * A CompositeViewer sends key events only to the view under the mouse, but players sharing a keyboard
+ * each press their own keys, so every controller has to see every key.
+ */
+class KeyBroadcastHandler : public osgGA::GUIEventHandler {
+public:
+    /**
+     * @brief Adds a controller receiving the keys pressed in other views.
+     *
+     * @param controller The controller.
+     */
+    void addController(CameraController* controller);
+
+    virtual bool handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa);
+
+protected:
+    std::vector<osg::ref_ptr<CameraController>> controllers; // Controllers of all views
+};
+
+/**
+ * @class SplitScreen
+ * @brief Several views of one scene graph sharing a window, each moved by its own CameraController.
+ *
+ * Every view renders the same root node, so the meshes, the texture array and the maze grid exist once
+ * whatever the number of views. The views tile the window in a grid and share one graphics context,
+ * and the CompositeViewer can cull and draw them on separate threads.
+ */
+class SplitScreen {
+public:
+    /**
+     * @brief Constructor for SplitScreen, creates the views without a graphics context.
+     *
+     * @param count Number of views.
+     */
+    SplitScreen(int count);
+
+    /**
+     * @brief Creates the shared graphics context and gives every view its tile of it.
+     *
+     * @param scene The scene rendered by every view.
+     * @param x The x-coordinate of the window.
+     * @param y The y-coordinate of the window.
+     * @param width The width of the window or framebuffer.
+     * @param height The height of the window or framebuffer.
+     * @param offscreen Whether to render into a pbuffer instead of a window.
+     * @return bool - True if the graphics context was created, false otherwise.
+     */
+    bool setUp(osg::Node* scene, int x, int y, int width, int height, bool offscreen);
+
+    /**
+     * @brief Attaches a controller to a view and lets it receive the keys pressed in the other views.
+     *
+     * @param index The index of the view.
+     * @param controller The controller, created for getView(index).
+     */
+    void setController(int index, CameraController* controller);
+
+    /**
+     * @brief Gets the viewer rendering all views.
+     *
+     * @return osgViewer::CompositeViewer& - The viewer.
+     */
+    osgViewer::CompositeViewer& getViewer();
+
+    /**
+     * @brief Gets one of the views.
+     *
+     * @param index The index of the view.
+     * @return osgViewer::View* - The view.
+     */
+    osgViewer::View* getView(int index) const;
+
+    /**
+     * @brief Gets the number of views.
+     *
+     * @return int - Number of views.
+     */
+    int getNumViews() const;
+
+protected:
+    osg::ref_ptr<osgViewer::CompositeViewer> viewer; // Renders all views
+    std::vector<osg::ref_ptr<osgViewer::View>> views; // One view per player
+    osg::ref_ptr<KeyBroadcastHandler> broadcaster; // Shared key handler of all views
+};
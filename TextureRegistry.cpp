@@ -0,0 +1,79 @@
+#include "TextureRegistry.h"
+
+namespace {
+
+// Passes the layer through with the texture coordinates, lighting is disabled for the whole scene
+const char* arrayVertexShader =
+    "#version 120\n"
+    "varying vec3 texCoord;\n"
+    "void main() {\n"
+    "    texCoord = gl_MultiTexCoord0.xyz;\n"
+    "    gl_Position = ftransform();\n"
+    "}\n";
+
+const char* arrayFragmentShader =
+    "#version 120\n"
+    "#extension GL_EXT_texture_array : enable\n"
+    "uniform sampler2DArray blockTextures;\n"
+    "varying vec3 texCoord;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2DArray(blockTextures, texCoord);\n"
+    "}\n";
+
+}
+
+osg::StateSet* TextureRegistry::getTextureArrayStateSet() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!arrayStateSet.valid()) {
+        arrayStateSet = createTextureArrayStateSet();
+    }
+    return arrayStateSet.get();
+}
+
+osg::StateSet* TextureRegistry::createTextureArrayStateSet() {
+    std::vector<std::string> paths = getBlockTexturePaths();
+    osg::ref_ptr<osg::Texture2DArray> array = new osg::Texture2DArray;
+    int width = 0, height = 0;
+    for (size_t layer = 0; layer < paths.size(); layer++) {
+        osg::ref_ptr<osg::Image> image = osgDB::readImageFile(paths[layer]);
+        if (!image) {
+            std::cerr << "Missing texture array layer " << paths[layer] << std::endl;
+            continue;
+        }
+        if (layer == 0) {
+            width = image->s();
+            height = image->t();
+        } else if (image->s() != width || image->t() != height) {
+            // Every layer of an array has the same size
+            std::cerr << "Resizing " << paths[layer] << " to " << width << "x" << height << std::endl;
+            image->scaleImage(width, height, 1);
+        }
+        array->setImage(static_cast<unsigned>(layer), image.get());
+    }
+    array->setTextureSize(width, height, static_cast<int>(paths.size()));
+    array->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_LINEAR);
+    array->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+    array->setUseHardwareMipMapGeneration(true);
+    array->setDataVariance(osg::Object::STATIC);
+
+    osg::ref_ptr<osg::Program> program = new osg::Program;
+    program->addShader(new osg::Shader(osg::Shader::VERTEX, arrayVertexShader));
+    program->addShader(new osg::Shader(osg::Shader::FRAGMENT, arrayFragmentShader));
+
+    osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+    stateSet->setTextureAttribute(0, array.get());
+    stateSet->setAttributeAndModes(program.get());
+    stateSet->addUniform(new osg::Uniform("blockTextures", 0));
+    stateSet->setDataVariance(osg::Object::STATIC);
+    return stateSet.release();
+}
+
+void TextureRegistry::printStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cout << "TEXTURE ARRAY: ";
+    if (arrayStateSet.valid()) {
+        std::cout << getBlockTexturePaths().size() << " layers" << std::endl;
+    } else {
+        std::cout << "not built" << std::endl;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <osg/ref_ptr>
+#include <osg/Texture2DArray>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Uniform>
+#include <osgDB/ReadFile>
+
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BlockTextures.h"
+
+/**
+ * @class TextureRegistry
+ * @brief Shared material of the block textures of the maze.
+ *
+ * The block textures are decoded once and packed into a single osg::Texture2DArray sampled by a small shader,
+ * which lets the whole maze share one StateSet and pick the texture per vertex.
+ * The StateSet is built under a mutex, so chunks can be built on several threads.
+ */
+class TextureRegistry {
+public:
+    /**
+     * @brief Gets the shared StateSet drawing the block textures from a texture array, built on first use.
+     *
+     * Layers follow getBlockTexturePaths(), the shader reads the layer from the z texture coordinate of unit 0.
+     *
+     * @return osg::StateSet* - Pointer to the shared StateSet.
+     */
+    osg::StateSet* getTextureArrayStateSet();
+
+    /**
+     * @brief Prints the number of layers of the texture array to the console.
+     */
+    void printStats() const;
+
+protected:
+    osg::ref_ptr<osg::StateSet> arrayStateSet; // StateSet binding the block texture array and its shader
+    mutable std::mutex mutex; // Guards the array
+
+    /**
+     * @brief Packs the block textures into a mipmapped texture array and creates its StateSet.
+     *
+     * @return osg::StateSet* - Pointer to the created StateSet.
+     */
+    osg::StateSet* createTextureArrayStateSet();
+};
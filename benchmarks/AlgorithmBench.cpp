@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../MazeAlgorithms.h"
+#include "../MazeSolver.h"
+
+// g++ -O2 -o algorithm_bench benchmarks/AlgorithmBench.cpp MazeAlgorithms.cpp EllerGenerator.cpp MazeGrid.cpp MazeFile.cpp Random.cpp MazeSolver.cpp
+// Usage: ./algorithm_bench [SIZE...]
+// Prints one CSV line per algorithm and size:
+// algorithm,size,seconds,cells_per_s,work_bytes,work_bytes_per_cell,dead_ends,dead_end_ratio,mean_corridor,solution_length
+
+/**
+ * @struct MazeMetrics
+ * @brief Shape of a generated maze.
+ */
+struct MazeMetrics {
+    size_t deadEnds = 0; // Rooms with a single opening
+    double deadEndRatio = 0.0; // Dead ends per room
+    double meanCorridor = 0.0; // Mean number of cells between two junctions or dead ends
+    int solutionLength = -1; // Steps from START to END
+};
+
+/**
+ * @brief Measures dead ends, corridor lengths and the solution length of a maze.
+ *
+ * @param maze The maze.
+ * @return MazeMetrics - The metrics.
+ */
+MazeMetrics measure(std::shared_ptr<const MazeGrid> maze) {
+    int size = maze->getSize();
+    size_t rooms = 0, corridorCells = 0, branchEnds = 0;
+    MazeMetrics metrics;
+    for (int x = 1; x < size - 1; x += 2) {
+        for (int y = 1; y < size - 1; y += 2) {
+            int degree = (maze->get(x - 1, y) != WALL) + (maze->get(x + 1, y) != WALL)
+                       + (maze->get(x, y - 1) != WALL) + (maze->get(x, y + 1) != WALL);
+            rooms++;
+            metrics.deadEnds += degree == 1;
+            if (degree == 2) {
+                corridorCells++;
+            } else {
+                branchEnds += degree;
+            }
+        }
+    }
+
+    // Rooms of degree 2 lie inside corridors, every other room ends as many corridors as its degree
+    metrics.deadEndRatio = static_cast<double>(metrics.deadEnds) / rooms;
+    size_t corridors = branchEnds / 2;
+    metrics.meanCorridor = corridors ? 2.0 * (corridorCells + corridors) / corridors : 0.0;
+
+    MazeSolver solver(maze);
+    metrics.solutionLength = solver.getDistanceBitParallel(1, 1, size-1, size-2);
+    return metrics;
+}
+
+/**
+ * @brief Generates one maze with a policy and prints its line.
+ *
+ * @param size Size of the maze.
+ */
+template <class Algorithm>
+void bench(int size) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    PolicyMazeGenerator<Algorithm> generator(size, 1);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    double cells = static_cast<double>(size) * size;
+    size_t workBytes = generator.getPolicy().getMemoryUsage();
+    MazeMetrics metrics = measure(generator.getMaze());
+    std::cout << getAlgorithmName(Algorithm::algorithm) << "," << size << "," << seconds << "," << cells / seconds << ","
+              << workBytes << "," << workBytes / cells << "," << metrics.deadEnds << "," << metrics.deadEndRatio << ","
+              << metrics.meanCorridor << "," << metrics.solutionLength << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {101, 1001, 3001};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; i++) {
+            sizes.push_back(std::atoi(argv[i]) | 1);
+        }
+    }
+
+    std::cout << "algorithm,size,seconds,cells_per_s,work_bytes,work_bytes_per_cell,dead_ends,dead_end_ratio,mean_corridor,solution_length" << std::endl;
+    for (int size : sizes) {
+        bench<DfsPolicy>(size);
+        bench<KruskalPolicy>(size);
+        bench<PrimPolicy>(size);
+        bench<WilsonPolicy>(size);
+        bench<EllerPolicy>(size);
+        bench<BinaryTreePolicy>(size);
+    }
+
+    return 0;
+}
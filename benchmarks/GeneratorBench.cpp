@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../MazeGenerator.h"
+#include "../EllerGenerator.h"
+
+// g++ -O2 -o generator_bench benchmarks/GeneratorBench.cpp MazeGenerator.cpp MazeAlgorithms.cpp MazeGrid.cpp MazeFile.cpp EllerGenerator.cpp Random.cpp
+// Usage: ./generator_bench [SIZE...]
+// Prints one CSV line per generator and size: generator,size,seconds,rows_per_s,cells_per_s
+// eller_file streams the maze to a maze file through MazeFileSink. The run fails if its row state grows
+// faster than the width of the maze, which would mean rows are being held instead of streamed.
+
+#define BENCH_STREAM_PATH "generator_bench.maze" // Maze file written by the eller_file run, removed afterwards
+#define STREAM_BYTES_PER_COLUMN 64 // Upper bound of the streaming row state per column of the maze
+
+/**
+ * @class CountingSink
+ * @brief Row sink that only counts open cells, so the benchmark measures generation alone.
+ */
+class CountingSink : public MazeRowSink {
+public:
+    size_t openCells = 0; // Number of non-wall cells seen
+
+    virtual void writeRow(int /*x*/, const CellType* row) {
+        for (int j = 0; j < size; j++) {
+            openCells += row[j] != WALL;
+        }
+    }
+
+    virtual void beginMaze(int size) {
+        this->size = size;
+    }
+
+protected:
+    int size = 0; // The size (width and height) of the maze
+};
+
+/**
+ * @brief Prints one result line in CSV format.
+ *
+ * @param generator Name of the generator.
+ * @param size Size of the maze.
+ * @param seconds Time the generation took.
+ */
+void report(const char* generator, int size, double seconds) {
+    double cells = static_cast<double>(size) * size;
+    std::cout << generator << "," << size << "," << seconds << "," << size / seconds << "," << cells / seconds << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {1001, 3001, 10001};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; i++) {
+            sizes.push_back(std::atoi(argv[i]) | 1);
+        }
+    }
+
+    std::cout << "generator,size,seconds,rows_per_s,cells_per_s" << std::endl;
+    for (int size : sizes) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        {
+            MazeGenerator maze(size, 1, 1, 1, false);
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        report("dfs", size, std::chrono::duration<double>(endTime - startTime).count());
+
+        CountingSink sink;
+        startTime = std::chrono::high_resolution_clock::now();
+        EllerGenerator eller(size, 1);
+        eller.generate(sink);
+        endTime = std::chrono::high_resolution_clock::now();
+        report("eller", size, std::chrono::duration<double>(endTime - startTime).count());
+
+        MazeFileInfo info;
+        info.startX = 1;
+        info.startY = 1;
+        info.endX = size - 1;
+        info.endY = size - 2;
+        info.seed = 1;
+        info.algorithm = ALGORITHM_ELLER;
+        MazeFileSink fileSink(BENCH_STREAM_PATH, info);
+        startTime = std::chrono::high_resolution_clock::now();
+        EllerGenerator streamer(size, 1);
+        streamer.generate(fileSink);
+        endTime = std::chrono::high_resolution_clock::now();
+        std::remove(BENCH_STREAM_PATH);
+        if (!fileSink.isWritten()) {
+            std::cerr << "Cannot write " << BENCH_STREAM_PATH << std::endl;
+            return 1;
+        }
+        report("eller_file", size, std::chrono::duration<double>(endTime - startTime).count());
+
+        size_t rowState = streamer.getMemoryUsage() + fileSink.getMemoryUsage();
+        if (rowState > static_cast<size_t>(STREAM_BYTES_PER_COLUMN) * size) {
+            std::cerr << "Streaming row state of " << rowState << " bytes is not proportional to the width " << size << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../MazeGenerator.h"
+#include "../MazeCollision.h"
+#include "../BlockTextures.h"
+
+// g++ -O2 -o micro_bench benchmarks/MicroBench.cpp MazeGenerator.cpp MazeAlgorithms.cpp EllerGenerator.cpp MazeGrid.cpp MazeFile.cpp MazeCollision.cpp BlockTextures.cpp Random.cpp
+// Usage: ./micro_bench [ITERATIONS]
+// Runs headless, no window or graphics context is created.
+// The collision_move param is the move length in fixed time steps at full speed.
+// Prints one CSV line per benchmark: benchmark,param,iterations,seconds,ops_per_s,ns_per_op
+
+#define BENCH_MAZE_SIZE 1001 // Maze used by the collision benchmarks
+#define BENCH_POSITIONS 4096 // Number of distinct camera positions probed
+#define BENCH_RADIUS 0.15 // Radius of the collision circle, the camera's distance from walls
+
+/**
+ * @brief Prints one result line in CSV format.
+ *
+ * @param benchmark Name of the benchmark.
+ * @param param Parameter of the run, such as the maze size.
+ * @param iterations Number of operations performed.
+ * @param seconds Time the operations took.
+ */
+void report(const std::string& benchmark, int param, long long iterations, double seconds) {
+    std::cout << benchmark << "," << param << "," << iterations << "," << seconds << ","
+              << iterations / seconds << "," << seconds * 1e9 / iterations << std::endl;
+}
+
+/**
+ * @brief Picks a weighted texture index by scanning the cumulative weights, the sampler the alias table replaced.
+ *
+ * @param rng The generator to draw from.
+ * @return int - Index of the selected texture.
+ */
+int linearTextureIndex(Random& rng) {
+    int totalWeight = 0;
+    for (const auto& tex : textureWeights) {
+        totalWeight += tex.second;
+    }
+
+    int randomNumber = static_cast<int>(rng.nextBelow(static_cast<uint32_t>(totalWeight))) + 1;
+    int cumulativeWeight = 0;
+    for (size_t i = 0; i < textureWeights.size(); i++) {
+        cumulativeWeight += textureWeights[i].second;
+        if (randomNumber <= cumulativeWeight) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Measures the wall-clock time of a callable.
+ *
+ * @param body The code to measure.
+ * @return double - Elapsed time in seconds.
+ */
+template <typename Body>
+double measure(Body body) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    body();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+int main(int argc, char* argv[]) {
+    long long iterations = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    Random rng(1);
+    std::cout << "benchmark,param,iterations,seconds,ops_per_s,ns_per_op" << std::endl;
+
+    // Maze generation across sizes
+    for (int size : {25, 51, 101, 501, 1001, 3001}) {
+        int runs = std::max(1, 2000000 / (size * size));
+        double seconds = measure([&]() {
+            for (int r = 0; r < runs; r++) {
+                MazeGenerator maze(size, 1, 1, r, false);
+            }
+        });
+        report("maze_generator", size, runs, seconds);
+    }
+
+    // Collision queries on camera positions spread over the open cells
+    MazeGenerator generator(BENCH_MAZE_SIZE, 1, 1, 1, false);
+    std::shared_ptr<const MazeGrid> maze = generator.getMaze();
+    MazeCollision collision(maze, BENCH_RADIUS);
+
+    std::vector<osg::Vec3d> positions;
+    while (positions.size() < BENCH_POSITIONS) {
+        int x = 1 + static_cast<int>(rng.nextBelow(BENCH_MAZE_SIZE - 2)), y = 1 + static_cast<int>(rng.nextBelow(BENCH_MAZE_SIZE - 2));
+        if (maze->get(x, y) != WALL) {
+            positions.push_back(osg::Vec3d(x + rng.nextDouble() - 0.5, y + rng.nextDouble() - 0.5, 0.25));
+        }
+    }
+
+    long long valid = 0;
+    double seconds = measure([&]() {
+        for (long long i = 0; i < iterations; i++) {
+            const osg::Vec3d& pos = positions[i % BENCH_POSITIONS];
+            valid += collision.overlaps(pos.x(), pos.y());
+        }
+    });
+    report("collision_overlaps", BENCH_MAZE_SIZE, iterations, seconds);
+
+    // Moves of one fixed time step and moves long enough to cross several cells
+    double checksum = 0.0;
+    for (int step : {1, 100}) {
+        double length = step * 1.5 / 120.0;
+        seconds = measure([&]() {
+            for (long long i = 0; i < iterations; i++) {
+                const osg::Vec3d& pos = positions[i % BENCH_POSITIONS];
+                double angle = (i % 360) * 0.0174533;
+                osg::Vec3d target(pos.x() + length * std::cos(angle), pos.y() + length * std::sin(angle), pos.z());
+                checksum += collision.move(pos, target).x();
+            }
+        });
+        report("collision_move", step, iterations, seconds);
+    }
+
+    // Weighted texture selection with the alias table, and with the former linear scan for comparison
+    long long length = 0;
+    seconds = measure([&]() {
+        for (long long i = 0; i < iterations; i++) {
+            length += getRandomTextureIndex(rng);
+        }
+    });
+    report("texture_alias", static_cast<int>(textureWeights.size()), iterations, seconds);
+    seconds = measure([&]() {
+        for (long long i = 0; i < iterations; i++) {
+            length += linearTextureIndex(rng);
+        }
+    });
+    report("texture_linear", static_cast<int>(textureWeights.size()), iterations, seconds);
+
+    // Keep the results alive so the loops are not optimized away
+    std::cerr << "checksum: " << valid << " " << checksum << " " << length << std::endl;
+
+    return 0;
+}
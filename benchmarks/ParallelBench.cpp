@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../ParallelMazeGenerator.h"
+
+// g++ -O2 -pthread -o parallel_bench benchmarks/ParallelBench.cpp ParallelMazeGenerator.cpp MazeGrid.cpp MazeFile.cpp Random.cpp
+// Usage: ./parallel_bench [SIZE] [MAX_THREADS] [SEED]
+// Prints one CSV line per thread count: threads,size,seconds,cells_per_s,speedup,hash
+// The hash must be the same on every line, the output does not depend on the thread count.
+
+/**
+ * @brief Computes an FNV-1a hash over the packed maze rows.
+ *
+ * @param maze The maze grid.
+ * @return uint64_t - The hash value.
+ */
+uint64_t hashMaze(const MazeGrid& maze) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (int x = 0; x < maze.getSize(); x++) {
+        const uint64_t* row = maze.getRow(x);
+        for (size_t w = 0; w < maze.getRowWords(); w++) {
+            hash = (hash ^ row[w]) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+int main(int argc, char* argv[]) {
+    int size = argc > 1 ? std::atoi(argv[1]) | 1 : 10001;
+    unsigned maxThreads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+
+    // Powers of two up to the maximum, plus the maximum itself
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "threads,size,seconds,cells_per_s,speedup,hash" << std::endl;
+    double baseline = 0.0;
+    for (unsigned threads : threadCounts) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ParallelMazeGenerator generator(size, seed, threads);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        if (baseline == 0.0) {
+            baseline = seconds;
+        }
+        std::cout << threads << "," << size << "," << seconds << "," << static_cast<double>(size) * size / seconds << ","
+                  << baseline / seconds << "," << std::hex << hashMaze(*generator.getMaze()) << std::dec << std::endl;
+    }
+
+    return 0;
+}
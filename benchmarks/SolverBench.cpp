@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../ParallelMazeGenerator.h"
+#include "../MazeSolver.h"
+#include "../MazeDistanceField.h"
+
+// g++ -O2 -pthread -o solver_bench benchmarks/SolverBench.cpp ParallelMazeGenerator.cpp MazeGrid.cpp MazeFile.cpp Random.cpp MazeSolver.cpp MazeDistanceField.cpp
+// Usage: ./solver_bench [SIZE...]
+// The default size 10001 gives a maze of 10^8 cells.
+// Prints one CSV line per solver and size: solver,size,seconds,cells_per_s,distance
+// All solvers must report the same distance from START to END.
+
+#define BENCH_SEED 1 // Seed of the benchmarked mazes
+#define BENCH_QUERIES 10000000 // Number of distance field lookups timed per maze
+#define BENCH_COMPACT_QUERIES 100000 // Number of compact distance field lookups timed per maze, each walks up to 64 rooms
+
+/**
+ * @brief Measures the wall-clock time of a callable.
+ *
+ * @param body The code to measure.
+ * @return double - Elapsed time in seconds.
+ */
+template <typename Body>
+double measure(Body body) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    body();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+/**
+ * @brief Prints one result line in CSV format.
+ *
+ * @param solver Name of the solver.
+ * @param size Size of the maze.
+ * @param seconds Time the solver took.
+ * @param work Number of cells or queries processed.
+ * @param distance Reported distance from START to END.
+ */
+void report(const std::string& solver, int size, double seconds, double work, long long distance) {
+    std::cout << solver << "," << size << "," << seconds << "," << work / seconds << "," << distance << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; i++) {
+        sizes.push_back(std::atoi(argv[i]) | 1);
+    }
+    if (sizes.empty()) {
+        sizes.push_back(10001);
+    }
+
+    std::cout << "solver,size,seconds,cells_per_s,distance" << std::endl;
+    for (int size : sizes) {
+        ParallelMazeGenerator generator(size, BENCH_SEED);
+        std::shared_ptr<const MazeGrid> maze = generator.getMaze();
+        MazeSolver solver(maze);
+        double cells = static_cast<double>(size) * size;
+
+        std::vector<std::pair<int, int>> path;
+        double seconds = measure([&]() { path = solver.findPath(1, 1, size-1, size-2); });
+        report("bfs", size, seconds, cells, static_cast<long long>(path.size()) - 1);
+
+        seconds = measure([&]() { path = solver.findPathAStar(1, 1, size-1, size-2); });
+        report("astar", size, seconds, cells, static_cast<long long>(path.size()) - 1);
+
+        int distance = 0;
+        seconds = measure([&]() { distance = solver.getDistanceBitParallel(1, 1, size-1, size-2); });
+        report("bit_parallel_bfs", size, seconds, cells, distance);
+
+        std::unique_ptr<DistanceField> field;
+        seconds = measure([&]() { field.reset(new MazeDistanceField(maze, size-1, size-2)); });
+        report("distance_field_build", size, seconds, cells, field->getDistance(1, 1));
+
+        // Lookups along the solved path, the same cells a player asking for hints would visit
+        unsigned long long checksum = 0;
+        seconds = measure([&]() {
+            for (long long q = 0; q < BENCH_QUERIES; q++) {
+                const std::pair<int, int>& cell = path[q % path.size()];
+                checksum += field->getDistance(cell.first, cell.second);
+            }
+        });
+        report("distance_field_query", size, seconds, BENCH_QUERIES, field->getDistance(1, 1));
+
+        // The field paged mazes use, a tenth of the memory for much slower distance lookups
+        seconds = measure([&]() { field.reset(new CompactDistanceField(maze, size-1, size-2)); });
+        report("compact_distance_field_build", size, seconds, cells, field->getDistance(1, 1));
+
+        seconds = measure([&]() {
+            for (long long q = 0; q < BENCH_COMPACT_QUERIES; q++) {
+                const std::pair<int, int>& cell = path[q % path.size()];
+                checksum += field->getDistance(cell.first, cell.second);
+            }
+        });
+        report("compact_distance_field_query", size, seconds, BENCH_COMPACT_QUERIES, field->getDistance(1, 1));
+        std::cerr << "checksum: " << checksum << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1 @@
+./dfsmem $1 & p=$!; m=0; while kill -0 $p 2>/dev/null; do v=$(grep VmHWM /proc/$p/status 2>/dev/null|awk '{print $2}'); [ -n "$v" ] && m=$v; sleep 0.05; done; echo peak $m KB